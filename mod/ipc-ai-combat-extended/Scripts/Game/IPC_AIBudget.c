@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - AI Budget
+// Splits the engine active-AI limit between the subsystems that spawn AI
+//
+// Every subsystem has a guaranteed minimum and a maximum share of the AI world limit
+// (IPC_ExtendedConfig m_fBudget*Share). A spawn is admitted when it keeps the subsystem under
+// its maximum and either fits in its own unused minimum or leaves every other subsystem's
+// unused minimum free. Usage is counted from the groups each subsystem spawned.
+// Spawn sizes are estimated as SpawnUnits() calls * members of the group prefab (its unit slots,
+// read once per prefab); m_iBudgetAgentsPerSpawnCall is only the fallback for unreadable prefabs.
+// Helicopter crews come from the airframe's default occupants and use m_iHelicopterCrewSize.
+//------------------------------------------------------------------------------------------------
+
+enum IPC_EAIBudgetSubsystem
+{
+	DEFENDERS,
+	ATTACKERS,
+	REINFORCEMENTS,
+	HELICOPTER_CREW
+}
+
+class IPC_AIBudget
+{
+	protected static ref IPC_AIBudget s_Instance;
+	protected static ref map<ResourceName, int> s_mPrefabMembers = new map<ResourceName, int>();	// Unit slots per group prefab
+
+	protected ref map<IPC_EAIBudgetSubsystem, ref array<SCR_AIGroup>> m_mGroups = new map<IPC_EAIBudgetSubsystem, ref array<SCR_AIGroup>>();
+	protected ref map<IPC_EAIBudgetSubsystem, int> m_mDenied = new map<IPC_EAIBudgetSubsystem, int>();
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_AIBudget GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_AIBudget();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Estimated agents for a number of SpawnUnits() calls of a group prefab
+	//------------------------------------------------------------------------------------------------
+	static int EstimateAgents(int spawnCalls, ResourceName groupPrefab)
+	{
+		return spawnCalls * GetPrefabMembers(groupPrefab);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Units one SpawnUnits() call of a group prefab creates (m_aUnitPrefabSlots, cached per prefab)
+	//------------------------------------------------------------------------------------------------
+	static int GetPrefabMembers(ResourceName groupPrefab)
+	{
+		if (s_mPrefabMembers.Contains(groupPrefab))
+			return s_mPrefabMembers.Get(groupPrefab);
+
+		int members = IPC_ExtendedConfig.GetInstance().m_iBudgetAgentsPerSpawnCall;
+
+		Resource resource = Resource.Load(groupPrefab);
+		if (resource && resource.IsValid())
+		{
+			BaseContainer container = resource.GetResource().ToBaseContainer();
+			array<ResourceName> unitSlots;
+			if (container && container.Get("m_aUnitPrefabSlots", unitSlots) && unitSlots && !unitSlots.IsEmpty())
+				members = unitSlots.Count();
+		}
+
+		s_mPrefabMembers.Insert(groupPrefab, members);
+		return members;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! May a subsystem spawn this many agents now (counts a denial if not)
+	//------------------------------------------------------------------------------------------------
+	bool CanSpawn(IPC_EAIBudgetSubsystem subsystem, int count)
+	{
+		if (!IPC_ExtendedConfig.GetInstance().m_bBudgetEnabled)
+			return true;
+
+		AIWorld aiWorld = GetGame().GetAIWorld();
+		if (!aiWorld)
+			return true;
+
+		int limit = aiWorld.GetLimitOfActiveAIs();
+		if (limit <= 0)
+			return true;
+
+		int free = limit - aiWorld.GetCurrentNumOfActiveAIs();
+		int used = GetUsage(subsystem);
+
+		float minShare, maxShare;
+		GetShares(subsystem, minShare, maxShare);
+
+		bool allowed;
+		if (used + count <= maxShare * limit && count <= free)
+		{
+			// Within own unused minimum - guaranteed
+			int ownReserve = Math.Max(minShare * limit - used, 0);
+			if (count <= ownReserve)
+				allowed = true;
+			else
+				allowed = count <= free - GetUnusedReservations(subsystem, limit);
+		}
+
+		if (!allowed)
+		{
+			m_mDenied.Set(subsystem, m_mDenied.Get(subsystem) + 1);
+			PrintFormat("[IPC Extended] AI budget: %1 spawn of %2 denied (using %3, share %4-%5 of %6, %7 free)",
+						typename.EnumToString(IPC_EAIBudgetSubsystem, subsystem), count, used, minShare, maxShare, limit, free);
+		}
+
+		return allowed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count a spawned group against a subsystem
+	//------------------------------------------------------------------------------------------------
+	void Track(SCR_AIGroup group, IPC_EAIBudgetSubsystem subsystem)
+	{
+		if (!group)
+			return;
+
+		array<SCR_AIGroup> groups = m_mGroups.Get(subsystem);
+		if (!groups)
+		{
+			groups = {};
+			m_mGroups.Insert(subsystem, groups);
+		}
+
+		if (!groups.Contains(group))
+			groups.Insert(group);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Alive agents in a subsystem's tracked groups (drops deleted groups)
+	//------------------------------------------------------------------------------------------------
+	int GetUsage(IPC_EAIBudgetSubsystem subsystem)
+	{
+		array<SCR_AIGroup> groups = m_mGroups.Get(subsystem);
+		if (!groups)
+			return 0;
+
+		int usage;
+		for (int i = groups.Count() - 1; i >= 0; i--)
+		{
+			if (!groups[i])
+			{
+				groups.Remove(i);
+				continue;
+			}
+
+			usage += groups[i].GetAgentsCount();
+		}
+
+		return usage;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! All tracked groups that still exist (every subsystem)
+	//------------------------------------------------------------------------------------------------
+	void GetTrackedGroups(notnull array<SCR_AIGroup> outGroups)
+	{
+		foreach (IPC_EAIBudgetSubsystem subsystem, array<SCR_AIGroup> groups : m_mGroups)
+		{
+			foreach (SCR_AIGroup group : groups)
+			{
+				if (group)
+					outGroups.Insert(group);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Sum of the unused minimums of all other subsystems
+	//------------------------------------------------------------------------------------------------
+	protected int GetUnusedReservations(IPC_EAIBudgetSubsystem exclude, int limit)
+	{
+		int reserved;
+		foreach (IPC_EAIBudgetSubsystem subsystem : GetSubsystems())
+		{
+			if (subsystem == exclude)
+				continue;
+
+			float minShare, maxShare;
+			GetShares(subsystem, minShare, maxShare);
+			reserved += Math.Max(minShare * limit - GetUsage(subsystem), 0);
+		}
+
+		return reserved;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static array<IPC_EAIBudgetSubsystem> GetSubsystems()
+	{
+		return {IPC_EAIBudgetSubsystem.DEFENDERS, IPC_EAIBudgetSubsystem.ATTACKERS, IPC_EAIBudgetSubsystem.REINFORCEMENTS, IPC_EAIBudgetSubsystem.HELICOPTER_CREW};
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Configured minimum / maximum share of the AI limit
+	//------------------------------------------------------------------------------------------------
+	protected static void GetShares(IPC_EAIBudgetSubsystem subsystem, out float minShare, out float maxShare)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		switch (subsystem)
+		{
+			case IPC_EAIBudgetSubsystem.DEFENDERS:
+				minShare = config.m_fBudgetDefenderMinShare;
+				maxShare = config.m_fBudgetDefenderMaxShare;
+				break;
+			case IPC_EAIBudgetSubsystem.ATTACKERS:
+				minShare = config.m_fBudgetAttackerMinShare;
+				maxShare = config.m_fBudgetAttackerMaxShare;
+				break;
+			case IPC_EAIBudgetSubsystem.REINFORCEMENTS:
+				minShare = config.m_fBudgetReinforcementMinShare;
+				maxShare = config.m_fBudgetReinforcementMaxShare;
+				break;
+			case IPC_EAIBudgetSubsystem.HELICOPTER_CREW:
+				minShare = config.m_fBudgetHelicopterMinShare;
+				maxShare = config.m_fBudgetHelicopterMaxShare;
+				break;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append budget state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		int limit;
+		AIWorld aiWorld = GetGame().GetAIWorld();
+		if (aiWorld)
+			limit = aiWorld.GetLimitOfActiveAIs();
+
+		foreach (IPC_EAIBudgetSubsystem subsystem : GetSubsystems())
+		{
+			float minShare, maxShare;
+			GetShares(subsystem, minShare, maxShare);
+			lines.Insert(string.Format("AI budget %1: %2 agents (share %3-%4 of %5) | %6 spawns denied",
+				typename.EnumToString(IPC_EAIBudgetSubsystem, subsystem), GetUsage(subsystem), minShare, maxShare, limit, m_mDenied.Get(subsystem)));
+		}
+	}
+}
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - AI Density Map
+// Shared uniform grid of the AI agents spawned by the addon, per faction
+//
+// Built from the groups IPC_AIBudget tracks (defenders, attackers, reinforcements, helicopter
+// crews) and rebuilt lazily at most once per m_iDensityMapInterval, so any number of queries in
+// between share one pass over the agents. A radius query only visits the cells it overlaps.
+//------------------------------------------------------------------------------------------------
+
+class IPC_DensityAgent
+{
+	vector m_vPosition;
+	string m_sFactionKey;
+}
+
+class IPC_AIDensityMap
+{
+	protected static const float CELL_SIZE = 100.0;	// m
+
+	protected static ref IPC_AIDensityMap s_Instance;
+
+	protected ref map<int, ref array<ref IPC_DensityAgent>> m_mCells = new map<int, ref array<ref IPC_DensityAgent>>();
+	protected float m_fBuildTime = -1;				// World time (ms) of the last rebuild
+	protected int m_iAgents;
+	protected int m_iRebuilds;
+	protected int m_iSaturationDeferrals;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_AIDensityMap GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_AIDensityMap();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count agents of a faction within radius of a position (XZ)
+	//------------------------------------------------------------------------------------------------
+	int CountAgents(vector position, string factionKey, float radius)
+	{
+		Refresh();
+
+		int minX = GetCellCoord(position[0] - radius);
+		int maxX = GetCellCoord(position[0] + radius);
+		int minZ = GetCellCoord(position[2] - radius);
+		int maxZ = GetCellCoord(position[2] + radius);
+		float radiusSq = radius * radius;
+		int count;
+
+		for (int x = minX; x <= maxX; x++)
+		{
+			for (int z = minZ; z <= maxZ; z++)
+			{
+				array<ref IPC_DensityAgent> cell = m_mCells.Get(GetCellKey(x, z));
+				if (!cell)
+					continue;
+
+				foreach (IPC_DensityAgent agent : cell)
+				{
+					if (agent.m_sFactionKey == factionKey && vector.DistanceSqXZ(agent.m_vPosition, position) < radiusSq)
+						count++;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Are at least cap agents of a faction within radius of a position (counts a deferral if so)
+	//! Not logged here - callers report state changes only (a crowded objective defers every check)
+	//------------------------------------------------------------------------------------------------
+	bool IsSaturated(vector position, string factionKey, float radius, int cap, out int count)
+	{
+		count = CountAgents(position, factionKey, radius);
+		if (count < cap)
+			return false;
+
+		m_iSaturationDeferrals++;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Rebuild the grid if it is older than m_iDensityMapInterval
+	//------------------------------------------------------------------------------------------------
+	protected void Refresh()
+	{
+		float now = GetGame().GetWorld().GetWorldTime();
+		if (m_fBuildTime >= 0 && now - m_fBuildTime < IPC_ExtendedConfig.GetInstance().m_iDensityMapInterval)
+			return;
+
+		int startTick = IPC_ScriptTimer.Start();
+
+		m_fBuildTime = now;
+		m_mCells.Clear();
+		m_iAgents = 0;
+		m_iRebuilds++;
+
+		array<SCR_AIGroup> groups = {};
+		IPC_AIBudget.GetInstance().GetTrackedGroups(groups);
+
+		array<AIAgent> agents = {};
+		foreach (SCR_AIGroup group : groups)
+		{
+			Faction faction = group.GetFaction();
+			if (!faction)
+				continue;
+
+			string factionKey = faction.GetFactionKey();
+			agents.Clear();
+			group.GetAgents(agents);
+
+			foreach (AIAgent agent : agents)
+			{
+				IEntity entity = agent.GetControlledEntity();
+				if (!entity)
+					continue;
+
+				IPC_DensityAgent sample = new IPC_DensityAgent();
+				sample.m_vPosition = entity.GetOrigin();
+				sample.m_sFactionKey = factionKey;
+
+				int key = GetCellKey(GetCellCoord(sample.m_vPosition[0]), GetCellCoord(sample.m_vPosition[2]));
+				array<ref IPC_DensityAgent> cell = m_mCells.Get(key);
+				if (!cell)
+				{
+					cell = {};
+					m_mCells.Insert(key, cell);
+				}
+
+				cell.Insert(sample);
+				m_iAgents++;
+			}
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static int GetCellCoord(float coord)
+	{
+		return Math.Floor(coord / CELL_SIZE);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pack cell coordinates into one key (covers +-100 km per axis)
+	//------------------------------------------------------------------------------------------------
+	protected static int GetCellKey(int x, int z)
+	{
+		return (x + 1024) * 2048 + (z + 1024);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append grid state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("AI density map: %1 agents in %2 cells | %3 rebuilds | %4 attacker spawns deferred (saturated)",
+			m_iAgents, m_mCells.Count(), m_iRebuilds, m_iSaturationDeferrals));
+	}
+}
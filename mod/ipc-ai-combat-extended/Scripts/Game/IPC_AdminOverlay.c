@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Admin Performance Overlay (server side)
+// Sends a small per-base status HUD to subscribed admins ("#ipcext overlay" toggles it)
+//
+// Rows are rebuilt once per m_iOverlayUpdateInterval (2 s by default) and diffed against what
+// each admin last received; only changed rows are sent (SCR_PlayerController RPC to the owner).
+// Running timers (combat / rear grace) are not part of the row text: the row carries TIMER_TOKEN
+// and the phase start time is diffed instead, so a row only changes when the phase does. The
+// client counts the timer up itself from the elapsed seconds sent with the row.
+// Nothing is built or sent while no admin is subscribed.
+//
+// Row 0:  AI load (active AI / AI world limit, load level), pending spawn jobs, queued tasks, mod script time
+// Row 1+: one per reinforcement coordinator - base, owner, combat state, wave, reinforcement AI,
+//         script time booked on the base over the last minute (IPC_BaseCostLedger)
+//------------------------------------------------------------------------------------------------
+
+class IPC_OverlayView
+{
+	ref array<string> m_aRows = {};					// Rows last sent to the admin
+	ref array<float> m_aTimerStarts = {};			// Timer start (world time ms, -1 = none) per row last sent
+}
+
+class IPC_AdminOverlay
+{
+	static const string TIMER_TOKEN = "{t}";			// Replaced by the running timer (s) on the client
+
+	protected static ref IPC_AdminOverlay s_Instance;
+	protected static int s_iScriptTimeMs;				// Mod script time accumulated since the last update
+
+	protected ref map<int, ref IPC_OverlayView> m_mSubscribers = new map<int, ref IPC_OverlayView>();	// Player ID -> state last sent
+	protected int m_iScheduledInterval;					// Update interval currently queued (0 = none)
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_AdminOverlay GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_AdminOverlay();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add time spent in mod script (ms, IPC_ScriptTimer) to the current measurement window
+	//------------------------------------------------------------------------------------------------
+	static void AddScriptTime(int ms)
+	{
+		s_iScriptTimeMs += ms;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Toggle the overlay for a player
+	//! \return true if the overlay is now shown
+	//------------------------------------------------------------------------------------------------
+	bool Toggle(int playerId)
+	{
+		if (m_mSubscribers.Contains(playerId))
+		{
+			m_mSubscribers.Remove(playerId);
+
+			// Empty payload hides the overlay on the client
+			SCR_PlayerController controller = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (controller)
+				controller.IPC_SendOverlayDelta(0, {}, {}, {});
+
+			if (m_mSubscribers.IsEmpty())
+				Schedule(0);
+
+			return false;
+		}
+
+		m_mSubscribers.Insert(playerId, new IPC_OverlayView());
+		Schedule(IPC_ExtendedConfig.GetInstance().m_iOverlayUpdateInterval);
+		Update();
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! (Re)schedule periodic updates (0 = stop)
+	//------------------------------------------------------------------------------------------------
+	protected void Schedule(int interval)
+	{
+		if (interval == m_iScheduledInterval)
+			return;
+
+		if (m_iScheduledInterval > 0)
+			GetGame().GetCallqueue().Remove(Update);
+
+		m_iScheduledInterval = interval;
+		s_iScriptTimeMs = 0;
+
+		if (interval > 0)
+			GetGame().GetCallqueue().CallLater(Update, interval, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build rows once and send each subscriber the rows that changed since its last update
+	//------------------------------------------------------------------------------------------------
+	protected void Update()
+	{
+		array<string> rows = {};
+		array<float> timerStarts = {};
+		BuildRows(rows, timerStarts);
+		s_iScriptTimeMs = 0;
+
+		float now = GetGame().GetWorld().GetWorldTime();
+
+		PlayerManager playerManager = GetGame().GetPlayerManager();
+		array<int> disconnected = {};
+
+		foreach (int playerId, IPC_OverlayView view : m_mSubscribers)
+		{
+			SCR_PlayerController controller = SCR_PlayerController.Cast(playerManager.GetPlayerController(playerId));
+			if (!controller)
+			{
+				disconnected.Insert(playerId);
+				continue;
+			}
+
+			array<int> changedIndices = {};
+			array<string> changedRows = {};
+			array<int> changedTimers = {};
+			foreach (int i, string row : rows)
+			{
+				if (i < view.m_aRows.Count() && view.m_aRows[i] == row && view.m_aTimerStarts[i] == timerStarts[i])
+					continue;
+
+				changedIndices.Insert(i);
+				changedRows.Insert(row);
+				changedTimers.Insert(GetElapsedSeconds(timerStarts[i], now));
+			}
+
+			if (changedIndices.IsEmpty() && view.m_aRows.Count() == rows.Count())
+				continue;
+
+			controller.IPC_SendOverlayDelta(rows.Count(), changedIndices, changedRows, changedTimers);
+			view.m_aRows.Copy(rows);
+			view.m_aTimerStarts.Copy(timerStarts);
+		}
+
+		foreach (int playerId : disconnected)
+		{
+			m_mSubscribers.Remove(playerId);
+		}
+
+		if (m_mSubscribers.IsEmpty())
+			Schedule(0);
+		else
+			Schedule(IPC_ExtendedConfig.GetInstance().m_iOverlayUpdateInterval);	// Follow live config reloads
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Seconds elapsed since a timer start (-1 if the row has no timer)
+	//------------------------------------------------------------------------------------------------
+	protected int GetElapsedSeconds(float timerStart, float now)
+	{
+		if (timerStart < 0)
+			return -1;
+
+		int elapsed = Math.Floor((now - timerStart) / 1000.0);
+		return elapsed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build all rows, with the start time of each row's timer (world time ms, -1 = none) in timerStarts
+	//------------------------------------------------------------------------------------------------
+	protected void BuildRows(notnull array<string> rows, notnull array<float> timerStarts)
+	{
+		int activeAI, aiLimit;
+		int loadLevel = GetAILoadLevel(activeAI, aiLimit);
+
+		float scriptMsPerSecond;
+		if (m_iScheduledInterval > 0)
+			scriptMsPerSecond = s_iScriptTimeMs * 1000.0 / m_iScheduledInterval;
+
+		rows.Insert(string.Format("AI %1/%2 (load %3) | spawn jobs %4 | tasks %5 | script %6 ms/s",
+			activeAI, aiLimit, loadLevel, IPC_SpawnRingCache.GetInstance().GetPendingCount(), IPC_TaskRunner.GetInstance().GetCount(), scriptMsPerSecond.ToString(-1, 1)));
+		timerStarts.Insert(-1);
+
+		IPC_AutonomousCaptureSystem autonomousSystem = IPC_AutonomousCaptureSystem.GetInstance();
+		if (!autonomousSystem)
+			return;
+
+		array<IPC_SpawnPointComponent> spawnPoints = {};
+		autonomousSystem.GetPatrols(spawnPoints);
+
+		foreach (IPC_SpawnPointComponent spawnPoint : spawnPoints)
+		{
+			IPC_DefenderSpawnPointComponent defender = IPC_DefenderSpawnPointComponent.Cast(spawnPoint);
+			if (!defender || !defender.IsReinforcementCoordinator() || !defender.GetNearBase())
+				continue;
+
+			SCR_CampaignMilitaryBaseComponent base = defender.GetNearBase();
+			string owner = "-";
+			if (base.GetFaction())
+				owner = base.GetFaction().GetFactionKey();
+
+			IPC_BaseDecisionState state = defender.GetDecisionState();
+			string combat = "idle";
+			float timerStart = -1;
+			if (state.m_bCombatActive)
+			{
+				combat = string.Format("combat %1s W%2", TIMER_TOKEN, state.m_iWave);
+				timerStart = state.m_fCombatStartTime;
+			}
+			else if (state.m_fInactiveSince >= 0)
+			{
+				combat = string.Format("rear %1s", TIMER_TOKEN);
+				timerStart = state.m_fInactiveSince;
+			}
+
+			string baseName = base.GetOwner().GetName();
+			rows.Insert(string.Format("%1 [%2] %3 | AI %4 | cpu %5 ms/min", baseName, owner, combat, defender.GetReinforcementAICount(),
+				IPC_BaseCostLedger.GetInstance().GetRecentMs(base)));
+			timerStarts.Insert(timerStart);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! AI load level from the AI world limit (0 = normal, 1 = elevated, 2 = high, 3 = at limit)
+	//------------------------------------------------------------------------------------------------
+	static int GetAILoadLevel(out int activeAI, out int aiLimit)
+	{
+		AIWorld aiWorld = GetGame().GetAIWorld();
+		if (!aiWorld)
+			return 0;
+
+		activeAI = aiWorld.GetCurrentNumOfActiveAIs();
+		aiLimit = aiWorld.GetLimitOfActiveAIs();
+		if (aiLimit <= 0)
+			return 0;
+
+		float ratio = activeAI / (aiLimit * 1.0);
+		if (ratio >= 0.95)
+			return 3;
+
+		if (ratio >= 0.8)
+			return 2;
+
+		if (ratio >= 0.6)
+			return 1;
+
+		return 0;
+	}
+}
@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Base Update Channels
+// Independently scheduled per-base work with its own cadence and "dirty" flag
+//
+// Every defender spawn point owns one channel per subsystem. A channel runs when its interval has
+// elapsed AND something was marked dirty since its last run; a due channel without pending
+// changes is skipped (counted) and waits for the next interval. Combat detection is driven by the
+// reinforcement director (m_iCheckInterval); group cleanup, frontline and the stuck watchdog are
+// driven by IPC_BaseChannelScheduler, one shared one-second tick over all spawn points that
+// captures a snapshot only when a channel actually runs.
+//------------------------------------------------------------------------------------------------
+
+enum IPC_EBaseChannel
+{
+	DETECTION,		// Combat detection / wave ladder (director tick)
+	GROUP_CLEANUP,	// Dead reinforcement groups
+	FRONTLINE,		// Rear base frontline / grace period
+	WATCHDOG		// Stuck reinforcement groups
+}
+
+class IPC_BaseChannel
+{
+	float m_fNextRun = -1;		// World time (ms), -1 = due now
+	bool m_bDirty = true;		// Changes pending since the last run (first run always happens)
+	int m_iRuns;
+	int m_iSkips;
+}
+
+class IPC_StuckRecord
+{
+	SCR_AIGroup m_Group;
+	vector m_vLastPosition;
+	bool m_bHasPosition;			// False until the first watchdog check saw the group (or after combat)
+	SCR_CampaignMilitaryBaseComponent m_SourceBase;	// Approach the group was sent on (null = direct)
+	ref array<vector> m_aRoute;
+}
+
+class IPC_BaseChannels
+{
+	static const int CHANNEL_COUNT = 4;
+
+	protected ref array<ref IPC_BaseChannel> m_aChannels = {};
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_BaseChannels()
+	{
+		for (int i = 0; i < CHANNEL_COUNT; i++)
+		{
+			m_aChannels.Insert(new IPC_BaseChannel());
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Flag pending work for a channel (runs at its next due time)
+	//------------------------------------------------------------------------------------------------
+	void MarkDirty(IPC_EBaseChannel channel)
+	{
+		m_aChannels[channel].m_bDirty = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Should a channel run now - due and dirty (clears the flag and schedules the next run)
+	//------------------------------------------------------------------------------------------------
+	bool Consume(IPC_EBaseChannel channel, float now)
+	{
+		IPC_BaseChannel entry = m_aChannels[channel];
+		if (entry.m_fNextRun >= 0 && now < entry.m_fNextRun)
+			return false;
+
+		entry.m_fNextRun = now + GetInterval(channel);
+
+		if (!entry.m_bDirty)
+		{
+			entry.m_iSkips++;
+			return false;
+		}
+
+		entry.m_bDirty = false;
+		entry.m_iRuns++;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	IPC_BaseChannel Get(IPC_EBaseChannel channel)
+	{
+		return m_aChannels[channel];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Channel cadence from the live config (ms, 0 = every call of its driver)
+	//------------------------------------------------------------------------------------------------
+	static int GetInterval(IPC_EBaseChannel channel)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		switch (channel)
+		{
+			case IPC_EBaseChannel.GROUP_CLEANUP: return config.m_iGroupCleanupInterval;
+			case IPC_EBaseChannel.FRONTLINE: return config.m_iFrontlineInterval;
+			case IPC_EBaseChannel.WATCHDOG: return config.m_iStuckWatchdogInterval;
+		}
+
+		return 0;
+	}
+}
+
+class IPC_BaseChannelScheduler
+{
+	protected static const int TICK_INTERVAL = 1000;	// ms - resolution of the channel cadences
+
+	protected static ref IPC_BaseChannelScheduler s_Instance;
+
+	protected ref array<IPC_DefenderSpawnPointComponent> m_aSpawnPoints = {};
+	protected ref IPC_CombatSnapshot m_Snapshot;		// Captured on demand, valid for one tick
+	protected bool m_bTicking;
+	protected bool m_bBaseEventsHooked;
+	protected int m_iStuckRecoveries;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_BaseChannelScheduler GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_BaseChannelScheduler();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start running the channels of a spawn point (once its base is known)
+	//------------------------------------------------------------------------------------------------
+	void Register(notnull IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		if (m_aSpawnPoints.Contains(spawnPoint))
+			return;
+
+		m_aSpawnPoints.Insert(spawnPoint);
+		HookBaseEvents();
+
+		if (!m_bTicking)
+		{
+			m_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, TICK_INTERVAL, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Unregister(IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		m_aSpawnPoints.RemoveItem(spawnPoint);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Snapshot (with bases) shared by every channel that runs in the current tick
+	//------------------------------------------------------------------------------------------------
+	IPC_CombatSnapshot GetSnapshot()
+	{
+		if (!m_Snapshot)
+			m_Snapshot = IPC_CombatSnapshot.Capture(true);
+
+		return m_Snapshot;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void CountStuckRecovery()
+	{
+		m_iStuckRecoveries++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+		float now = GetGame().GetWorld().GetWorldTime();
+		m_Snapshot = null;
+
+		for (int i = m_aSpawnPoints.Count() - 1; i >= 0; i--)
+		{
+			IPC_DefenderSpawnPointComponent spawnPoint = m_aSpawnPoints[i];
+			if (!spawnPoint)
+			{
+				m_aSpawnPoints.Remove(i);
+				continue;
+			}
+
+			spawnPoint.RunBaseChannels(now);
+		}
+
+		m_Snapshot = null;
+
+		if (m_aSpawnPoints.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			m_bTicking = false;
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Base ownership changes are the only input that can move the frontline
+	//------------------------------------------------------------------------------------------------
+	protected void HookBaseEvents()
+	{
+		if (m_bBaseEventsHooked)
+			return;
+
+		SCR_MilitaryBaseSystem baseSystem = SCR_MilitaryBaseSystem.GetInstance();
+		if (!baseSystem)
+			return;
+
+		baseSystem.GetOnBaseFactionChanged().Insert(OnBaseFactionChanged);
+		m_bBaseEventsHooked = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void OnBaseFactionChanged(SCR_MilitaryBaseComponent base, Faction faction)
+	{
+		foreach (IPC_DefenderSpawnPointComponent spawnPoint : m_aSpawnPoints)
+		{
+			if (!spawnPoint)
+				continue;
+
+			spawnPoint.GetBaseChannels().MarkDirty(IPC_EBaseChannel.FRONTLINE);
+			if (spawnPoint.GetNearBase() == base)
+				spawnPoint.GetBaseChannels().MarkDirty(IPC_EBaseChannel.DETECTION);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append run / skip counts per channel (all bases) to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		array<int> runs = {0, 0, 0, 0};
+		array<int> skips = {0, 0, 0, 0};
+
+		foreach (IPC_DefenderSpawnPointComponent spawnPoint : m_aSpawnPoints)
+		{
+			if (!spawnPoint)
+				continue;
+
+			for (int i = 0; i < IPC_BaseChannels.CHANNEL_COUNT; i++)
+			{
+				IPC_BaseChannel channel = spawnPoint.GetBaseChannels().Get(i);
+				runs[i] = runs[i] + channel.m_iRuns;
+				skips[i] = skips[i] + channel.m_iSkips;
+			}
+		}
+
+		lines.Insert(string.Format("Base channels (%1 spawn points, run/skipped): detection %2/%3 | group cleanup %4/%5 | frontline %6/%7 | watchdog %8/%9",
+			m_aSpawnPoints.Count(), runs[0], skips[0], runs[1], skips[1], runs[2], skips[2], runs[3], skips[3]));
+		lines.Insert(string.Format("Stuck watchdog: %1 groups re-routed", m_iStuckRecoveries));
+	}
+}
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Base Cost Ledger
+// Script time attributed to the base it was spent for, per work category, over rolling windows
+//
+// Call sites measure their own work with IPC_ScriptTimer and book it on the base component:
+// detection (combat detection, frontline), spawning (respawns including the parent mod's position
+// search, waves, helicopters), cleanup (dead groups) and waypoints (assignment, idle posture,
+// stuck watchdog). Every measurement is booked, including the many 0 ms ones - only the bucket
+// sums are meaningful (see IPC_ScriptTimer). Time is kept in 10 s buckets so the last minute and
+// the last m_iCostLedgerWindow seconds can be read back cheaply. Shown by "#ipcext stats" (most
+// expensive bases first) and per base on the admin overlay; every finished bucket is appended to
+// $profile:IPC_ExtendedBaseCost.csv, next to the wave metrics CSV.
+//------------------------------------------------------------------------------------------------
+
+enum IPC_ECostCategory
+{
+	DETECTION,
+	SPAWNING,
+	CLEANUP,
+	WAYPOINTS
+}
+
+class IPC_BaseCostEntry
+{
+	string m_sBaseName;
+	ref array<int> m_aBucketStamps = {};		// Bucket number (world time / BUCKET_MS) each slot currently holds
+	ref array<int> m_aBucketMs = {};			// Index: slot * CATEGORY_COUNT + category
+}
+
+class IPC_BaseCostLedger
+{
+	static const int CATEGORY_COUNT = 4;
+	protected static const int BUCKET_MS = 10000;
+	protected static const int SHORT_WINDOW_BUCKETS = 6;	// Last minute
+
+	protected static const string CSV_FILE_PATH = "$profile:IPC_ExtendedBaseCost.csv";
+
+	protected static ref IPC_BaseCostLedger s_Instance;
+
+	protected ref map<SCR_MilitaryBaseComponent, ref IPC_BaseCostEntry> m_mBases = new map<SCR_MilitaryBaseComponent, ref IPC_BaseCostEntry>();
+	protected int m_iWrittenBucket = -1;		// Last bucket appended to the CSV
+	protected bool m_bWriting;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_BaseCostLedger GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_BaseCostLedger();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Book the time since startTick (IPC_ScriptTimer.Start()) on a base (no-op without a base)
+	//------------------------------------------------------------------------------------------------
+	static void Add(SCR_MilitaryBaseComponent base, IPC_ECostCategory category, int startTick)
+	{
+		if (!base)
+			return;
+
+		GetInstance().AddCost(base, category, IPC_ScriptTimer.Elapsed(startTick));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddCost(notnull SCR_MilitaryBaseComponent base, IPC_ECostCategory category, int ms)
+	{
+		IPC_BaseCostEntry entry = m_mBases.Get(base);
+		if (!entry)
+		{
+			entry = new IPC_BaseCostEntry();
+			entry.m_sBaseName = base.GetOwner().GetName();
+			m_mBases.Insert(base, entry);
+		}
+
+		if (!m_bWriting)
+		{
+			m_bWriting = true;
+			GetGame().GetCallqueue().CallLater(WriteFinishedBuckets, BUCKET_MS, true);
+		}
+
+		// Window length follows live config reloads (history is dropped when it changes)
+		int slotCount = GetBucketCount();
+		if (entry.m_aBucketStamps.Count() != slotCount)
+		{
+			entry.m_aBucketStamps.Clear();
+			entry.m_aBucketMs.Clear();
+			for (int i = 0; i < slotCount; i++)
+			{
+				entry.m_aBucketStamps.Insert(-1);
+				for (int c = 0; c < CATEGORY_COUNT; c++)
+				{
+					entry.m_aBucketMs.Insert(0);
+				}
+			}
+		}
+
+		int bucket = GetCurrentBucket();
+		int slot = bucket % slotCount;
+		if (entry.m_aBucketStamps[slot] != bucket)
+		{
+			entry.m_aBucketStamps[slot] = bucket;
+			for (int category2 = 0; category2 < CATEGORY_COUNT; category2++)
+			{
+				entry.m_aBucketMs[slot * CATEGORY_COUNT + category2] = 0;
+			}
+		}
+
+		int index = slot * CATEGORY_COUNT + category;
+		entry.m_aBucketMs[index] = entry.m_aBucketMs[index] + ms;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Time booked on a base over the last minute (all categories, ms)
+	//------------------------------------------------------------------------------------------------
+	int GetRecentMs(SCR_MilitaryBaseComponent base)
+	{
+		IPC_BaseCostEntry entry = m_mBases.Get(base);
+		if (!entry)
+			return 0;
+
+		return GetWindowMs(entry, -1, SHORT_WINDOW_BUCKETS, GetCurrentBucket());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Sum of the buckets of the last bucketCount periods (category -1 = all)
+	//------------------------------------------------------------------------------------------------
+	protected int GetWindowMs(IPC_BaseCostEntry entry, int category, int bucketCount, int currentBucket)
+	{
+		int total;
+		foreach (int slot, int stamp : entry.m_aBucketStamps)
+		{
+			if (stamp < 0 || stamp <= currentBucket - bucketCount)
+				continue;
+
+			for (int c = 0; c < CATEGORY_COUNT; c++)
+			{
+				if (category < 0 || category == c)
+					total += entry.m_aBucketMs[slot * CATEGORY_COUNT + c];
+			}
+		}
+
+		return total;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append every bucket that finished since the last call to the CSV (one row per base and bucket)
+	//------------------------------------------------------------------------------------------------
+	protected void WriteFinishedBuckets()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+		int currentBucket = GetCurrentBucket();
+
+		bool newFile = !FileIO.FileExists(CSV_FILE_PATH);
+		FileHandle file = FileIO.OpenFile(CSV_FILE_PATH, FileMode.APPEND);
+		if (file)
+		{
+			if (newFile)
+				file.WriteLine("base,bucket_start_s,detection_ms,spawning_ms,cleanup_ms,waypoints_ms");
+
+			foreach (SCR_MilitaryBaseComponent base, IPC_BaseCostEntry entry : m_mBases)
+			{
+				foreach (int slot, int stamp : entry.m_aBucketStamps)
+				{
+					if (stamp <= m_iWrittenBucket || stamp >= currentBucket)
+						continue;
+
+					int index = slot * CATEGORY_COUNT;
+					file.WriteLine(string.Format("%1,%2,%3,%4,%5,%6", entry.m_sBaseName, stamp * BUCKET_MS / 1000,
+						entry.m_aBucketMs[index + IPC_ECostCategory.DETECTION], entry.m_aBucketMs[index + IPC_ECostCategory.SPAWNING],
+						entry.m_aBucketMs[index + IPC_ECostCategory.CLEANUP], entry.m_aBucketMs[index + IPC_ECostCategory.WAYPOINTS]));
+				}
+			}
+
+			file.Close();
+		}
+
+		m_iWrittenBucket = currentBucket - 1;
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int GetCurrentBucket()
+	{
+		return Math.Floor(GetGame().GetWorld().GetWorldTime() / BUCKET_MS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected int GetBucketCount()
+	{
+		return Math.Max(IPC_ExtendedConfig.GetInstance().m_iCostLedgerWindow * 1000 / BUCKET_MS, SHORT_WINDOW_BUCKETS);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append the most expensive bases of the long window to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		int currentBucket = GetCurrentBucket();
+		int bucketCount = GetBucketCount();
+
+		// Order bases by long window cost (insertion sort, a few dozen bases at most)
+		array<IPC_BaseCostEntry> ordered = {};
+		array<int> orderedMs = {};
+		int allMs;
+
+		foreach (SCR_MilitaryBaseComponent base, IPC_BaseCostEntry entry : m_mBases)
+		{
+			int windowMs = GetWindowMs(entry, -1, bucketCount, currentBucket);
+			allMs += windowMs;
+
+			int position = ordered.Count();
+			while (position > 0 && orderedMs[position - 1] < windowMs)
+			{
+				position--;
+			}
+
+			ordered.InsertAt(entry, position);
+			orderedMs.InsertAt(windowMs, position);
+		}
+
+		lines.Insert(string.Format("Base cost ledger: %1 bases | %2 ms in the last %3s (top %4 below, ms last 1m / %3s)",
+			m_mBases.Count(), allMs, bucketCount * BUCKET_MS / 1000, config.m_iCostLedgerTopBases));
+
+		int shown = Math.Min(ordered.Count(), config.m_iCostLedgerTopBases);
+		for (int i = 0; i < shown; i++)
+		{
+			IPC_BaseCostEntry top = ordered[i];
+
+			float share;
+			if (allMs > 0)
+				share = orderedMs[i] * 100.0 / allMs;
+
+			lines.Insert(string.Format("  %1: %2 / %3 (%4 pct) | detection %5 | spawning %6 | cleanup %7 | waypoints %8",
+				top.m_sBaseName, GetWindowMs(top, -1, SHORT_WINDOW_BUCKETS, currentBucket), orderedMs[i], Math.Round(share),
+				GetWindowMs(top, IPC_ECostCategory.DETECTION, bucketCount, currentBucket),
+				GetWindowMs(top, IPC_ECostCategory.SPAWNING, bucketCount, currentBucket),
+				GetWindowMs(top, IPC_ECostCategory.CLEANUP, bucketCount, currentBucket),
+				GetWindowMs(top, IPC_ECostCategory.WAYPOINTS, bucketCount, currentBucket)));
+		}
+	}
+}
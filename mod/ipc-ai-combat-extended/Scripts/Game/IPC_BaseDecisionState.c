@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Base Decision State
+// Wave ladder and rear-base grace period state of one spawn point, driven only by snapshot data
+//
+// Holds no entity references and never spawns anything: the spawn point asks it what to do
+// and performs the action itself. The trace replay drives the same class with recorded inputs.
+// All times are world time in milliseconds.
+//------------------------------------------------------------------------------------------------
+
+class IPC_BaseDecisionState
+{
+	static const int MAX_GROUND_WAVE = 3;		// Wave 4 (helicopter) is temporarily disabled
+
+	// Wave ladder
+	bool m_bCombatActive;						// Is reinforcement mode active
+	int m_iWave;								// Current wave number (0=none, 1=first, 2=second, ...)
+	float m_fCombatStartTime = -1;				// When combat started at this base
+	float m_fLastWaveTime = -1;					// When last reinforcement spawned (-1 = never)
+
+	// Rear base grace period
+	float m_fInactiveSince = -1;				// When base became inactive (-1 = active)
+
+	//------------------------------------------------------------------------------------------------
+	//! Is an alive attacker (player not of the base owner faction) in detection range of a base
+	//------------------------------------------------------------------------------------------------
+	static bool IsUnderAttack(notnull IPC_CombatSnapshot snapshot, int baseIndex)
+	{
+		IPC_BaseProximity proximity = snapshot.GetBaseProximity(baseIndex);
+		return proximity && proximity.m_iAttackers > 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Is a base of any hostile faction within frontline range (unknown hostiles or bases count as frontline)
+	//------------------------------------------------------------------------------------------------
+	static bool IsOnFrontline(notnull IPC_FrontlineMap frontline, notnull IPC_CombatSnapshot snapshot, int baseIndex, notnull array<string> hostileFactionKeys)
+	{
+		if (hostileFactionKeys.IsEmpty() || snapshot.m_aBases.IsEmpty() || baseIndex < 0)
+			return true;
+
+		return frontline.HasContact(snapshot, baseIndex, hostileFactionKeys);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Advance combat tracking with the latest detection result
+	//! \param[out] started combat tracking started this update
+	//! \param[out] ended combat ended this update (state was reset)
+	//! \return wave that is due now (0 = none)
+	//------------------------------------------------------------------------------------------------
+	int UpdateCombat(bool combatActive, float now, out bool started, out bool ended)
+	{
+		started = false;
+		ended = false;
+
+		// Start tracking combat
+		if (combatActive && !m_bCombatActive)
+		{
+			m_fCombatStartTime = now;
+			m_bCombatActive = true;
+			started = true;
+		}
+
+		// Reset if combat stopped
+		if (!combatActive && m_bCombatActive)
+		{
+			ResetCombat();
+			ended = true;
+			return 0;
+		}
+
+		if (!m_bCombatActive)
+			return 0;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		// Prevent re-triggering within cooldown period
+		if (m_fLastWaveTime >= 0 && (now - m_fLastWaveTime) / 1000.0 < config.m_fWaveCooldown)
+			return 0;
+
+		// Check waves in priority order (Wave 3 -> Wave 2 -> Wave 1)
+		float combatDuration = GetCombatDuration(now);
+		for (int wave = MAX_GROUND_WAVE; wave > m_iWave; wave--)
+		{
+			if (combatDuration >= config.GetWaveThreshold(wave))
+				return wave;
+		}
+
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record that a due wave was actually triggered
+	//------------------------------------------------------------------------------------------------
+	void OnWaveTriggered(int wave, float now)
+	{
+		m_iWave = wave;
+		m_fLastWaveTime = now;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Combat duration in seconds (0 if not in combat)
+	//------------------------------------------------------------------------------------------------
+	float GetCombatDuration(float now)
+	{
+		if (!m_bCombatActive)
+			return 0;
+
+		return (now - m_fCombatStartTime) / 1000.0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Reset reinforcement tracking (wave cooldown is kept)
+	//------------------------------------------------------------------------------------------------
+	void ResetCombat()
+	{
+		m_bCombatActive = false;
+		m_iWave = 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Advance the rear-base grace period of a friendly base
+	//! \param[out] graceStarted base became inactive this update
+	//! \return true to keep defenders active, false once the grace period expired
+	//------------------------------------------------------------------------------------------------
+	bool UpdateGracePeriod(bool onFrontline, float now, out bool graceStarted)
+	{
+		graceStarted = false;
+
+		// Frontline base - keep active and reset grace period
+		if (onFrontline)
+		{
+			m_fInactiveSince = -1;
+			return true;
+		}
+
+		// Start grace period if not already started
+		if (m_fInactiveSince < 0)
+		{
+			m_fInactiveSince = now;
+			graceStarted = true;
+			return true;
+		}
+
+		return GetInactiveDuration(now) < IPC_ExtendedConfig.GetInstance().m_iInactiveGracePeriod;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Time since the base became inactive in seconds (0 if active)
+	//------------------------------------------------------------------------------------------------
+	float GetInactiveDuration(float now)
+	{
+		if (m_fInactiveSince < 0)
+			return 0;
+
+		return (now - m_fInactiveSince) / 1000.0;
+	}
+}
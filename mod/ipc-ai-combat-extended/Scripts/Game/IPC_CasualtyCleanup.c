@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Casualty Cleanup
+// Removes bodies, dropped weapons and wrecks left behind by reinforcement waves
+//
+// Reinforcement soldiers (with the weapons they spawned with) and wave 4 helicopters are
+// tracked from spawn. Once dead / destroyed they are removed after m_fCasualtyLifetime seconds,
+// or after m_fCasualtyUnwatchedLifetime while no alive player is within m_fCasualtyPlayerRange.
+// Both lifetimes shrink linearly as the number of tracked casualty entities approaches
+// m_iCasualtyEntityThreshold (zero at the threshold). Expired entities are deleted by an
+// IPC_DespawnTask on the task runner; weapons picked up by a player are left alone.
+// Everything else stays with the game's garbage manager.
+//------------------------------------------------------------------------------------------------
+
+class IPC_TrackedCasualty
+{
+	IEntity m_Entity;
+	ref array<IEntity> m_aWeapons = {};		// Weapons carried at spawn (deleted with the body if still on the ground)
+	float m_fDeathTime = -1;				// World time (ms), -1 = alive
+}
+
+class IPC_CasualtyCleanup
+{
+	protected static const int CHECK_INTERVAL = 10000;	// ms
+
+	protected static ref IPC_CasualtyCleanup s_Instance;
+
+	protected ref array<ref IPC_TrackedCasualty> m_aTracked = {};
+	protected bool m_bTicking;
+	protected int m_iRemoved;
+	protected int m_iLastDeadEntities;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_CasualtyCleanup GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_CasualtyCleanup();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Track every soldier of a reinforcement group (and the weapons they carry)
+	//------------------------------------------------------------------------------------------------
+	void TrackGroup(SCR_AIGroup group)
+	{
+		if (!group || !IPC_ExtendedConfig.GetInstance().m_bCasualtyCleanupEnabled)
+			return;
+
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+
+		foreach (AIAgent agent : agents)
+		{
+			IEntity character = agent.GetControlledEntity();
+			if (!character)
+				continue;
+
+			IPC_TrackedCasualty casualty = new IPC_TrackedCasualty();
+			casualty.m_Entity = character;
+
+			BaseWeaponManagerComponent weaponManager = BaseWeaponManagerComponent.Cast(character.FindComponent(BaseWeaponManagerComponent));
+			if (weaponManager)
+				weaponManager.GetWeaponsList(casualty.m_aWeapons);
+
+			Add(casualty);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Track a reinforcement vehicle (removing the wreck also removes the crew inside)
+	//------------------------------------------------------------------------------------------------
+	void TrackVehicle(IEntity vehicle)
+	{
+		if (!vehicle || !IPC_ExtendedConfig.GetInstance().m_bCasualtyCleanupEnabled)
+			return;
+
+		IPC_TrackedCasualty casualty = new IPC_TrackedCasualty();
+		casualty.m_Entity = vehicle;
+		Add(casualty);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Add(IPC_TrackedCasualty casualty)
+	{
+		m_aTracked.Insert(casualty);
+
+		if (!m_bTicking)
+		{
+			m_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, CHECK_INTERVAL, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Detect new casualties and queue expired ones for removal
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		IPC_CombatSnapshot snapshot = IPC_CombatSnapshot.Capture(false);
+		float now = snapshot.m_fTime;
+
+		// Entity pressure: lifetimes shrink towards zero as the threshold is approached
+		int deadEntities;
+		foreach (IPC_TrackedCasualty tracked : m_aTracked)
+		{
+			if (tracked.m_Entity && tracked.m_fDeathTime >= 0)
+				deadEntities += 1 + tracked.m_aWeapons.Count();
+		}
+		m_iLastDeadEntities = deadEntities;
+
+		float lifetimeScale = Math.Clamp(1 - deadEntities / (config.m_iCasualtyEntityThreshold * 1.0), 0, 1);
+		float rangeSq = config.m_fCasualtyPlayerRange * config.m_fCasualtyPlayerRange;
+
+		IPC_DespawnTask despawnTask;
+
+		for (int i = m_aTracked.Count() - 1; i >= 0; i--)
+		{
+			IPC_TrackedCasualty casualty = m_aTracked[i];
+
+			// Deleted elsewhere (wave despawn, garbage manager)
+			if (!casualty.m_Entity || casualty.m_Entity.IsDeleted())
+			{
+				m_aTracked.Remove(i);
+				continue;
+			}
+
+			if (casualty.m_fDeathTime < 0)
+			{
+				if (IsDead(casualty.m_Entity))
+					casualty.m_fDeathTime = now;
+
+				continue;
+			}
+
+			float lifetime = config.m_fCasualtyLifetime;
+			if (!IsWatched(snapshot, casualty.m_Entity.GetOrigin(), rangeSq))
+				lifetime = config.m_fCasualtyUnwatchedLifetime;
+
+			if (now - casualty.m_fDeathTime < lifetime * lifetimeScale * 1000)
+				continue;
+
+			if (!despawnTask)
+				despawnTask = new IPC_DespawnTask();
+
+			despawnTask.AddEntity(casualty.m_Entity);
+			m_iRemoved++;
+
+			// Weapons still lying on the ground (a parent means a player or container holds it)
+			foreach (IEntity weapon : casualty.m_aWeapons)
+			{
+				if (weapon && !weapon.GetParent())
+				{
+					despawnTask.AddEntity(weapon);
+					m_iRemoved++;
+				}
+			}
+
+			m_aTracked.Remove(i);
+		}
+
+		if (despawnTask)
+			IPC_TaskRunner.GetInstance().Add(despawnTask);
+
+		if (m_aTracked.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			m_bTicking = false;
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Dead character or destroyed vehicle
+	//------------------------------------------------------------------------------------------------
+	protected bool IsDead(IEntity entity)
+	{
+		CharacterControllerComponent controller = CharacterControllerComponent.Cast(entity.FindComponent(CharacterControllerComponent));
+		if (controller)
+			return controller.IsDead();
+
+		DamageManagerComponent damageManager = DamageManagerComponent.Cast(entity.FindComponent(DamageManagerComponent));
+		return damageManager && damageManager.GetState() == EDamageState.DESTROYED;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool IsWatched(IPC_CombatSnapshot snapshot, vector position, float rangeSq)
+	{
+		foreach (IPC_PlayerSample player : snapshot.m_aPlayers)
+		{
+			if (player.m_bAlive && vector.DistanceSqXZ(player.m_vPosition, position) < rangeSq)
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Tracked dead entities relative to m_iCasualtyEntityThreshold at the last check (1 = at threshold)
+	//------------------------------------------------------------------------------------------------
+	float GetPressure()
+	{
+		return m_iLastDeadEntities / (IPC_ExtendedConfig.GetInstance().m_iCasualtyEntityThreshold * 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append cleanup state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Casualty cleanup: %1 tracked | %2 dead entities (threshold %3) | %4 removed",
+			m_aTracked.Count(), m_iLastDeadEntities, IPC_ExtendedConfig.GetInstance().m_iCasualtyEntityThreshold, m_iRemoved));
+	}
+}
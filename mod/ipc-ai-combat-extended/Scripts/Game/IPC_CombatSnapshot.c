@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Combat Snapshot
+// Plain-data copy of every world input the combat logic consumes (players, bases, time)
+//
+// Live checks capture a snapshot and run the decision logic on it; the trace recorder writes
+// the same snapshot to disk and the replay rebuilds it, so both paths share one code path.
+// Per-base player checks read GetBaseProximity(), computed for all bases at once by one
+// IPC_ProximitySweep the first time any base asks.
+//------------------------------------------------------------------------------------------------
+
+class IPC_PlayerSample
+{
+	int m_iPlayerId;
+	vector m_vPosition;
+	string m_sFactionKey;		// Empty if the player has no faction
+	bool m_bAlive;
+}
+
+class IPC_BaseSample
+{
+	int m_iIndex;				// Stable index within a session / trace
+	string m_sName;
+	vector m_vPosition;
+	string m_sFactionKey;		// Empty if the base has no owner
+	SCR_CampaignMilitaryBaseComponent m_Base;	// Live only (null in replay)
+}
+
+class IPC_CombatSnapshot
+{
+	float m_fTime;				// World time (ms)
+	ref array<ref IPC_PlayerSample> m_aPlayers = {};
+	ref array<ref IPC_BaseSample> m_aBases = {};
+
+	protected ref map<SCR_CampaignMilitaryBaseComponent, int> m_mBaseIndices = new map<SCR_CampaignMilitaryBaseComponent, int>();	// Live only
+	protected ref map<int, ref IPC_BaseProximity> m_mProximity;		// Built on first request
+
+	//------------------------------------------------------------------------------------------------
+	//! Capture players (and optionally all bases) from the running world
+	//------------------------------------------------------------------------------------------------
+	static IPC_CombatSnapshot Capture(bool includeBases)
+	{
+		IPC_CombatSnapshot snapshot = new IPC_CombatSnapshot();
+		snapshot.m_fTime = GetGame().GetWorld().GetWorldTime();
+
+		PlayerManager playerManager = GetGame().GetPlayerManager();
+		if (playerManager)
+		{
+			array<int> playerIds = {};
+			playerManager.GetPlayers(playerIds);
+
+			foreach (int playerId : playerIds)
+			{
+				IEntity player = playerManager.GetPlayerControlledEntity(playerId);
+				if (!player)
+					continue;
+
+				SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(player);
+				if (!character)
+					continue;
+
+				IPC_PlayerSample sample = new IPC_PlayerSample();
+				sample.m_iPlayerId = playerId;
+				sample.m_vPosition = player.GetOrigin();
+
+				Faction playerFaction = character.GetFaction();
+				if (playerFaction)
+					sample.m_sFactionKey = playerFaction.GetFactionKey();
+
+				CharacterControllerComponent controller = CharacterControllerComponent.Cast(player.FindComponent(CharacterControllerComponent));
+				sample.m_bAlive = controller && !controller.IsDead();
+
+				snapshot.m_aPlayers.Insert(sample);
+			}
+		}
+
+		if (includeBases)
+			snapshot.CaptureBases();
+
+		return snapshot;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Capture position and owner of every campaign base
+	//------------------------------------------------------------------------------------------------
+	void CaptureBases()
+	{
+		SCR_GameModeCampaign gameMode = SCR_GameModeCampaign.GetInstance();
+		if (!gameMode)
+			return;
+
+		SCR_CampaignMilitaryBaseManager baseManager = gameMode.GetBaseManager();
+		if (!baseManager)
+			return;
+
+		array<SCR_CampaignMilitaryBaseComponent> bases = {};
+		baseManager.GetBases(bases);
+
+		foreach (int i, SCR_CampaignMilitaryBaseComponent base : bases)
+		{
+			IPC_BaseSample sample = new IPC_BaseSample();
+			sample.m_iIndex = i;
+			sample.m_sName = base.GetOwner().GetName();
+			sample.m_vPosition = base.GetOwner().GetOrigin();
+			sample.m_Base = base;
+
+			Faction baseFaction = base.GetFaction();
+			if (baseFaction)
+				sample.m_sFactionKey = baseFaction.GetFactionKey();
+
+			m_aBases.Insert(sample);
+			m_mBaseIndices.Insert(base, i);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Attacker count (within m_fCombatDetectionRange) and nearest player of a base (null if not captured)
+	//------------------------------------------------------------------------------------------------
+	IPC_BaseProximity GetBaseProximity(int baseIndex)
+	{
+		if (!m_mProximity)
+			m_mProximity = IPC_ProximitySweep.Evaluate(this, IPC_ExtendedConfig.GetInstance().m_fCombatDetectionRange);
+
+		return m_mProximity.Get(baseIndex);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count alive players of other factions within range of a position
+	//------------------------------------------------------------------------------------------------
+	int CountAttackersInRange(vector position, string defenderFactionKey, float range)
+	{
+		float rangeSq = range * range;
+		int count;
+
+		foreach (IPC_PlayerSample player : m_aPlayers)
+		{
+			if (!player.m_bAlive || player.m_sFactionKey.IsEmpty() || player.m_sFactionKey == defenderFactionKey)
+				continue;
+
+			if (vector.DistanceSq(player.m_vPosition, position) < rangeSq)
+				count++;
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Is any player (alive or not) on this faction
+	//------------------------------------------------------------------------------------------------
+	bool HasPlayerOfFaction(string factionKey)
+	{
+		if (factionKey.IsEmpty())
+			return false;
+
+		foreach (IPC_PlayerSample player : m_aPlayers)
+		{
+			if (player.m_sFactionKey == factionKey)
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the snapshot index of a live base (-1 if not captured)
+	//------------------------------------------------------------------------------------------------
+	int FindBaseIndex(SCR_CampaignMilitaryBaseComponent base)
+	{
+		if (!base || !m_mBaseIndices.Contains(base))
+			return -1;
+
+		return m_mBaseIndices.Get(base);
+	}
+}
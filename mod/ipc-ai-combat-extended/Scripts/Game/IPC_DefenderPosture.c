@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Defender Posture
+// Puts defender groups of bases far from every player into an idle hold-position posture
+//
+// Evaluated once per director tick on its shared snapshot (per-base proximity sweep), not per
+// group. A defender group goes idle when no alive player is within m_fIdleDefenderRange of its
+// base and the base has no attacker in detection range; its patrol waypoints are stashed so it
+// stops requesting paths. It wakes up (waypoints restored) as soon as an attacker shows up or a
+// player comes within IDLE_WAKE_RATIO of that range.
+//------------------------------------------------------------------------------------------------
+
+class IPC_DefenderPosture
+{
+	protected static const float IDLE_WAKE_RATIO = 0.8;	// Hysteresis - wake closer than the idle range
+
+	protected static ref IPC_DefenderPosture s_Instance;
+
+	protected int m_iIdle;
+	protected int m_iTransitions;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_DefenderPosture GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_DefenderPosture();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Switch defender groups between idle and patrol from one snapshot (needs captured bases)
+	//------------------------------------------------------------------------------------------------
+	void Update(notnull IPC_CombatSnapshot snapshot)
+	{
+		IPC_AutonomousCaptureSystem autonomousSystem = IPC_AutonomousCaptureSystem.GetInstance();
+		if (!autonomousSystem)
+			return;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		array<IPC_SpawnPointComponent> spawnPoints = {};
+		autonomousSystem.GetPatrols(spawnPoints);
+
+		m_iIdle = 0;
+
+		foreach (IPC_SpawnPointComponent spawnPoint : spawnPoints)
+		{
+			IPC_DefenderSpawnPointComponent defender = IPC_DefenderSpawnPointComponent.Cast(spawnPoint);
+			if (!defender || !defender.GetNearBase())
+				continue;
+
+			bool idle = defender.IsIdlePosture();
+			bool wantIdle;
+
+			IPC_BaseProximity proximity = snapshot.GetBaseProximity(snapshot.FindBaseIndex(defender.GetNearBase()));
+			if (config.m_bIdleDefenders && proximity && proximity.m_iAttackers == 0)
+			{
+				float range = config.m_fIdleDefenderRange;
+				if (idle)
+					range *= IDLE_WAKE_RATIO;
+
+				wantIdle = proximity.m_fNearestPlayerDistance < 0 || proximity.m_fNearestPlayerDistance > range;
+			}
+
+			if (wantIdle != idle)
+			{
+				int startTick = IPC_ScriptTimer.Start();
+				defender.SetIdlePosture(wantIdle);
+				IPC_BaseCostLedger.Add(defender.GetNearBase(), IPC_ECostCategory.WAYPOINTS, startTick);
+				m_iTransitions++;
+			}
+
+			if (defender.IsIdlePosture())
+				m_iIdle++;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append posture state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Defender posture: %1 groups idle | %2 transitions", m_iIdle, m_iTransitions));
+	}
+}
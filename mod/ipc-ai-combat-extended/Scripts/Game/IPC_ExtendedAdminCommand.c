@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Admin Command
+// Server command for live administration of the addon (chat "#ipcext <sub>" or RCON "ipcext <sub>")
+//
+// Sub-commands:
+//   reload - reload IPC_ExtendedConfig from the server profile and apply it to all spawn points
+//   stats  - print subsystem stats (reinforcement pools, ...) to the log and the caller
+//   record start|stop [name] - record combat logic inputs to $profile:IPC_ExtendedTrace_<name>.txt
+//   replay [name]            - replay a recorded trace through the decision logic (no spawning, summary in the log)
+//   overlay - toggle the performance overlay HUD for the calling admin (chat only)
+//------------------------------------------------------------------------------------------------
+
+class IPC_ExtendedAdminCommand : ScrServerCommand
+{
+	//------------------------------------------------------------------------------------------------
+	override string GetKeyword()
+	{
+		return "ipcext";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool IsServerSide()
+	{
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override int RequiredRCONPermission()
+	{
+		return ERCONPermissions.PERMISSIONS_ADMIN;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override int RequiredChatPermission()
+	{
+		return EPlayerRole.ADMINISTRATOR;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatServerExecution(array<string> argv, int playerId)
+	{
+		return HandleCommand(argv, playerId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnChatClientExecution(array<string> argv, int playerId)
+	{
+		return ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnRCONExecution(array<string> argv)
+	{
+		return HandleCommand(argv, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override ref ScrServerCmdResult OnUpdate()
+	{
+		return ScrServerCmdResult(string.Empty, EServerCmdResultType.OK);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Dispatch sub-command (argv[0] is the keyword itself, playerId 0 = RCON)
+	//------------------------------------------------------------------------------------------------
+	protected ScrServerCmdResult HandleCommand(array<string> argv, int playerId)
+	{
+		if (argv.Count() < 2)
+			return ScrServerCmdResult("Usage: #ipcext <reload|stats|record|replay|overlay>", EServerCmdResultType.PARAMETERS);
+
+		string subCommand = argv[1];
+		subCommand.ToLower();
+
+		if (subCommand == "reload")
+		{
+			if (IPC_ExtendedConfig.Reload())
+				return ScrServerCmdResult("IPC Extended configuration reloaded", EServerCmdResultType.OK);
+
+			return ScrServerCmdResult("IPC Extended configuration not loaded - see server log", EServerCmdResultType.ERR);
+		}
+
+		if (subCommand == "stats")
+			return ScrServerCmdResult(IPC_ExtendedStats.Dump(), EServerCmdResultType.OK);
+
+		if (subCommand == "overlay")
+		{
+			if (playerId <= 0)
+				return ScrServerCmdResult("The overlay is only available from in-game chat", EServerCmdResultType.ERR);
+
+			if (IPC_AdminOverlay.GetInstance().Toggle(playerId))
+				return ScrServerCmdResult("IPC Extended overlay enabled", EServerCmdResultType.OK);
+
+			return ScrServerCmdResult("IPC Extended overlay disabled", EServerCmdResultType.OK);
+		}
+
+		string traceName;
+		if (argv.Count() > 3)
+			traceName = argv[3];
+
+		if (subCommand == "record")
+		{
+			string action;
+			if (argv.Count() > 2)
+				action = argv[2];
+			action.ToLower();
+
+			if (action != "start" && action != "stop")
+				return ScrServerCmdResult("Usage: #ipcext record start|stop [name]", EServerCmdResultType.PARAMETERS);
+
+			if (action == "stop")
+			{
+				IPC_TraceRecorder.Stop();
+				return ScrServerCmdResult("Trace recording stopped", EServerCmdResultType.OK);
+			}
+
+			if (IPC_TraceRecorder.Start(traceName))
+				return ScrServerCmdResult(string.Format("Trace recording started: %1", IPC_TraceRecorder.GetTracePath(traceName)), EServerCmdResultType.OK);
+
+			return ScrServerCmdResult("Trace recording failed - see server log", EServerCmdResultType.ERR);
+		}
+
+		if (subCommand == "replay")
+		{
+			if (argv.Count() > 2)
+				traceName = argv[2];
+
+			return ScrServerCmdResult(IPC_TraceReplay.Run(traceName), EServerCmdResultType.OK);
+		}
+
+		return ScrServerCmdResult(string.Format("Unknown sub-command: %1", subCommand), EServerCmdResultType.PARAMETERS);
+	}
+}
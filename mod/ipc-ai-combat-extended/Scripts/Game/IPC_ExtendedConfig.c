@@ -0,0 +1,462 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Runtime Configuration
+// Holds every server tunable of the addon and loads it from the server profile as JSON
+//
+// File: $profile:IPC_ExtendedCombat.json (written with defaults on first server start)
+// Reload: admin chat/RCON command "#ipcext reload", or automatically when the file changes
+//         (if m_iConfigWatchInterval > 0)
+// On reload the new values are pushed to every registered spawn point (ApplyExtendedConfig)
+//------------------------------------------------------------------------------------------------
+
+class IPC_ExtendedConfig
+{
+	//------------------------------------------------------------------------------------------------
+	// SERIALIZED TUNABLES (JSON keys match member names)
+	//------------------------------------------------------------------------------------------------
+
+	// Reinforcement checks
+	int m_iCheckInterval = 30000;						// Coordinator check interval (ms)
+	float m_fCombatDetectionRange = 300.0;				// Distance to detect player activity (m)
+	float m_fWaveCooldown = 10.0;						// Minimum time between two waves (s)
+	ref array<int> m_aWaveThresholds = {300, 600, 900, 1200};	// Combat duration per wave (s)
+
+	// Normal spawn parameters
+	int m_iDefenderRespawnTime = 180;					// Defender respawn period (s)
+	int m_iDefenderGroupCount = 2;						// Defender SpawnUnits() calls
+	bool m_bIdleDefenders = true;						// Defenders of bases far from every player hold position
+	float m_fIdleDefenderRange = 2000.0;				// Nearest player beyond this = idle (wakes at 80%) (m)
+	int m_iAttackerRespawnTime = 90;					// Attacker respawn period (s)
+	int m_iAttackerGroupCount = 1;						// Attacker SpawnUnits() calls
+	bool m_bAttackerSaturationGate = true;				// Defer attacker respawns while the objective is crowded
+	int m_iAttackerSaturationCap = 24;					// Friendly AI near the objective that defers attacker respawns
+	float m_fAttackerSaturationRadius = 200.0;			// Objective radius for the saturation check (m)
+	int m_iDensityMapInterval = 5000;					// Max age of the shared AI density grid (ms)
+
+	// Population controller (scales the respawn periods and group counts above at runtime)
+	bool m_bPopulationControl = true;
+	int m_iPopulationTarget = 120;						// Active AI the controller steers towards
+	float m_fPopulationFrameBudgetMs = 33.0;			// Average server frame time the controller stays under (ms)
+	int m_iPopulationControlInterval = 10000;			// Control loop period (ms)
+	float m_fPopulationGain = 0.2;						// Scale change per tick at 100 pct error
+	float m_fPopulationDamping = 0.3;					// Share of the desired change applied per tick (0-1)
+	float m_fPopulationMinScale = 0.25;					// Slowest spawn rate (x configured, sqrt on period and count each)
+	float m_fPopulationMaxScale = 2.0;					// Fastest spawn rate (x configured, sqrt on period and count each)
+
+	// Reinforcement spawn parameters
+	int m_iReinforcementGroupCount = 1;					// Groups per wave 1/2 (and SpawnUnits() calls per group)
+	float m_fReinforcementSpawnRadius = 200.0;			// Spawn dispersion radius (m)
+
+	// Spawn ring cache (navmesh-validated spawn/waypoint candidates per base)
+	float m_fSpawnRingInnerRadius = 100.0;				// Ring starts this far from the base (m)
+	int m_iSpawnRingCandidates = 24;					// Spawn candidates generated per base
+	int m_iWaypointCandidates = 6;						// Waypoint candidates generated per base
+	int m_iSpawnSlotsPerPosition = 12;					// Formation slots validated around every unit spawn position
+	float m_fSpawnSlotSpacing = 2.5;					// Distance between formation slots (m)
+	int m_iRingValidationsPerFrame = 1;					// Validation queries (sphere or navmesh) per frame
+
+	// Task runner (multi-frame script work: ring validation, wave despawn, delayed alerts)
+	int m_iTaskFrameBudgetMs = 2;						// Script time per frame for queued tasks (ms, at least one step always runs)
+
+	// Reinforcement source base (spawn at nearest friendly base and move in along a cached road-snapped route)
+	bool m_bSpawnAtFriendlyBase = false;				// false = spawn around the attacked base (default)
+	float m_fSourceBaseMinDistance = 800.0;				// Ignore friendly bases closer than this (inside the AO)
+	float m_fSourceBaseMaxDistance = 4000.0;			// Ignore friendly bases further than this
+	float m_fSourceBasePlayerClearance = 500.0;			// No player may be this close to the source base
+	float m_fSourceBaseSpawnRadius = 50.0;				// Spawn dispersion around the source base (m)
+	float m_fRouteSampleSpacing = 250.0;				// Distance between route points (m)
+	float m_fRouteRoadSnapDistance = 150.0;				// Max distance to snap a route point to a road (m)
+	string m_sMoveWaypointPrefab = "{750A8D1695BD6998}Prefabs/AI/Waypoints/AIWaypoint_Move.et";
+	int m_iWaypointStaggerMs = 750;						// Delay between waypoint assignments of one base's groups (ms)
+
+	// Reinforcement director (faction-wide wave scheduling across engaged bases)
+	int m_iDirectorWavesPerTick = 2;					// Waves one faction may spawn per check (all bases combined)
+	string m_sDirectorMode = "spread";					// "spread" = one wave per base by threat, "concentrate" = top threat bases only
+	float m_fDirectorConcentrateRatio = 0.5;			// Concentrate: bases below this share of the top threat wait
+
+	// Per-base update channels (combat detection runs every m_iCheckInterval; each channel skips while nothing changed)
+	int m_iGroupCleanupInterval = 30000;				// Dead reinforcement group cleanup (ms)
+	int m_iFrontlineInterval = 10000;					// Rear base frontline / grace period check (ms)
+	int m_iStuckWatchdogInterval = 60000;				// Stuck reinforcement group check (ms)
+	float m_fStuckDistance = 10.0;						// Group moving less between two checks outside the base is stuck (m)
+
+	// Per-base cost ledger ("#ipcext stats")
+	int m_iCostLedgerWindow = 600;						// Long rolling window (s) - the short one is always the last minute
+	int m_iCostLedgerTopBases = 5;						// Most expensive bases listed in the stats dump
+
+	// AI budget (share of the engine active-AI limit per subsystem, 0-1)
+	bool m_bBudgetEnabled = true;						// Enforce reservations at every spawn call site
+	int m_iBudgetAgentsPerSpawnCall = 4;				// Agents per SpawnUnits() call when the group prefab cannot be read
+	int m_iHelicopterCrewSize = 4;						// Default occupants of the wave 4 helicopter (pilot and turret seats)
+	float m_fBudgetDefenderMinShare = 0.25;				// Defender respawns
+	float m_fBudgetDefenderMaxShare = 0.6;
+	float m_fBudgetAttackerMinShare = 0.2;				// Attacker respawns
+	float m_fBudgetAttackerMaxShare = 0.5;
+	float m_fBudgetReinforcementMinShare = 0.15;		// Reinforcement waves
+	float m_fBudgetReinforcementMaxShare = 0.4;
+	float m_fBudgetHelicopterMinShare = 0.0;			// Helicopter crews
+	float m_fBudgetHelicopterMaxShare = 0.1;
+
+	// Helicopter configuration
+	float m_fHelicopterSpawnDistance = 1500.0;			// Distance from base to spawn helicopter (m)
+	float m_fHelicopterSpawnAltitude = 200.0;			// Altitude above terrain to spawn helicopter (m)
+	bool m_bVirtualHelicopterApproach = true;			// Simulate the ingress abstractly, spawn the airframe near the AO
+	float m_fHelicopterApproachSpeed = 50.0;			// Virtual ingress speed (m/s)
+	float m_fHelicopterMaterializeDistance = 400.0;		// Spawn the real helicopter this far from the base (m)
+	float m_fHelicopterVisualRange = 1200.0;			// ...or as soon as a player is this close to it (m)
+
+	// Frontline detection for auto-despawn
+	int m_iInactiveGracePeriod = 600;					// Time before rear base defenders despawn (s)
+	float m_fFrontlineRange = 2000.0;					// Enemy base within this range = frontline (m)
+
+	// AI perception
+	float m_fSoloPerception = 1.0;						// Perception for defenders with a single player
+	float m_fReinforcementPerception = 1.5;				// Reinforcement perception (EXPERT skill)
+	float m_fHighPopPerception = 2.0;					// Reinforcement perception at high population (CYLON skill)
+
+	// Perception scaling (reinforcements in dense clusters far from players)
+	bool m_bPerceptionScaling = true;
+	float m_fPerceptionFullRange = 300.0;				// Nearest player this close = full perception (m)
+	float m_fPerceptionFarRange = 800.0;				// Nearest player this far = full reduction (m)
+	float m_fPerceptionDensityRadius = 100.0;			// Cluster radius around the group (m)
+	int m_iPerceptionDenseCount = 12;					// Other friendly AI in the cluster radius for full reduction
+	float m_fPerceptionMinFactor = 0.5;					// Perception share at full reduction
+	int m_iPerceptionGroupsPerTick = 2;					// Groups re-evaluated per second
+	int m_iHighPopPlayerCount = 10;						// Player count at which high population values apply
+
+	// Reinforcement pool (per-faction manpower points)
+	bool m_bPoolEnabled = true;							// Waves draw from a finite regenerating pool
+	float m_fPoolInitialPoints = 60.0;					// Points a faction starts with
+	float m_fPoolMaxPoints = 60.0;						// Pool cap
+	float m_fPoolRegenPerMinute = 2.0;					// Base regeneration
+	float m_fPoolRegenPerBasePerMinute = 0.25;			// Additional regeneration per base held
+	int m_iPoolCostFireteam = 4;						// Cost of a FIRETEAM group
+	int m_iPoolCostSquad = 8;							// Cost of a SQUAD_RIFLE group
+	int m_iPoolCostHelicopter = 12;						// Cost of the wave 4 helicopter
+
+	// Deterministic spawn decisions (0 = new seed every session)
+	int m_iRandomSeed = 0;
+
+	// Wave metrics
+	float m_fMetricsContactRange = 150.0;				// Hostile player this close to a group = contact (m)
+	float m_fMetricsIdleRange = 500.0;					// No hostile player this close = group is idle (m)
+
+	// Casualty cleanup (bodies, dropped weapons and wrecks of reinforcement waves)
+	bool m_bCasualtyCleanupEnabled = true;
+	float m_fCasualtyLifetime = 600.0;					// Seconds a casualty stays while a player is near
+	float m_fCasualtyUnwatchedLifetime = 120.0;			// Seconds a casualty stays with no player near
+	float m_fCasualtyPlayerRange = 300.0;				// Alive player this close = casualty is watched (m)
+	int m_iCasualtyEntityThreshold = 150;				// Lifetimes reach zero at this many tracked dead entities
+
+	// Lightweight loadout (reinforcements spawned while the AI or entity budget is under pressure)
+	ref array<string> m_aLightLoadoutGroupTypes = {"FIRETEAM", "SQUAD_RIFLE"};	// SCR_EGroupType names eligible for the light kit
+	ref array<string> m_aLightLoadoutGroupPrefabs = {};	// "<faction key>|<group type>|<group prefab>" spawned instead (else stripped)
+	float m_fLightLoadoutAIRatio = 0.7;					// Active AI / AI limit from which the light kit is used
+	float m_fLightLoadoutEntityRatio = 0.5;				// Casualty entities / m_iCasualtyEntityThreshold from which the light kit is used
+	int m_iLightLoadoutMagazines = 2;					// Spare magazines kept per soldier
+	int m_iLightLoadoutGrenades = 1;					// Grenades kept per soldier
+
+	// Admin performance overlay ("#ipcext overlay")
+	int m_iOverlayUpdateInterval = 2000;				// Server -> admin HUD update rate (ms)
+
+	// Debug
+	bool m_bDebugMode = false;							// Fast wave intervals and verbose logging
+	int m_iDebugWaveInterval = 60;						// Wave interval in debug mode (s)
+
+	// Config file watcher (ms, 0 = only reload via admin command)
+	int m_iConfigWatchInterval = 0;
+
+	//------------------------------------------------------------------------------------------------
+	// SINGLETON / FILE HANDLING
+	//------------------------------------------------------------------------------------------------
+
+	protected static const string CONFIG_FILE_PATH = "$profile:IPC_ExtendedCombat.json";
+
+	protected static ref IPC_ExtendedConfig s_Instance;
+	protected static string s_sLastFileContents;
+	protected static int s_iWatchInterval;
+
+	//------------------------------------------------------------------------------------------------
+	//! Get active configuration (loads from profile on first access on the server)
+	//------------------------------------------------------------------------------------------------
+	static IPC_ExtendedConfig GetInstance()
+	{
+		if (!s_Instance)
+		{
+			s_Instance = new IPC_ExtendedConfig();
+
+			// Clients keep defaults - only the server owns the profile config
+			if (Replication.IsServer())
+				Reload();
+		}
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Reload configuration from the profile and apply it to all spawn points
+	//! \return true once a configuration was applied (read from the file, or defaults written when there was none),
+	//! false if the file could not be parsed and the current configuration was kept
+	//------------------------------------------------------------------------------------------------
+	static bool Reload()
+	{
+		IPC_ExtendedConfig config = new IPC_ExtendedConfig();
+		bool loaded = false;
+
+		if (FileIO.FileExists(CONFIG_FILE_PATH))
+		{
+			SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+			if (!loadContext.LoadFromFile(CONFIG_FILE_PATH))
+			{
+				Print(string.Format("[IPC Extended] ERROR: Failed to parse %1 - keeping current configuration", CONFIG_FILE_PATH), LogLevel.ERROR);
+				return false;
+			}
+
+			// Missing keys keep their defaults; the file is rewritten below with the full key set
+			if (!loadContext.ReadValue("", config))
+				Print(string.Format("[IPC Extended] WARNING: %1 is incomplete - missing values use defaults", CONFIG_FILE_PATH), LogLevel.WARNING);
+
+			loaded = true;
+		}
+
+		config.Sanitize();
+		s_Instance = config;
+
+		// Write back so the file always lists every tunable with its current value
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("", config);
+		saveContext.SaveToFile(CONFIG_FILE_PATH);
+		s_sLastFileContents = ReadFileContents(CONFIG_FILE_PATH);
+
+		UpdateWatcher();
+		ApplyToSpawnPoints();
+		IPC_PopulationController.GetInstance().UpdateSchedule();
+		IPC_SpawnRingCache.GetInstance().OnConfigReloaded();
+		IPC_RouteCache.GetInstance().OnConfigReloaded();
+
+		if (loaded)
+			PrintFormat("[IPC Extended] Configuration loaded from %1", CONFIG_FILE_PATH);
+		else
+			PrintFormat("[IPC Extended] No configuration found - defaults written to %1", CONFIG_FILE_PATH);
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Push current values to every registered spawn point (per-base state objects)
+	//------------------------------------------------------------------------------------------------
+	static void ApplyToSpawnPoints()
+	{
+		IPC_AutonomousCaptureSystem autonomousSystem = IPC_AutonomousCaptureSystem.GetInstance();
+		if (!autonomousSystem)
+			return;
+
+		array<IPC_SpawnPointComponent> allSpawnPoints = {};
+		autonomousSystem.GetPatrols(allSpawnPoints);
+
+		foreach (IPC_SpawnPointComponent spawnPoint : allSpawnPoints)
+		{
+			if (spawnPoint)
+				spawnPoint.ApplyExtendedConfig(s_Instance);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! (Re)schedule the file watcher when its interval changed
+	//------------------------------------------------------------------------------------------------
+	protected static void UpdateWatcher()
+	{
+		if (s_iWatchInterval == s_Instance.m_iConfigWatchInterval)
+			return;
+
+		if (s_iWatchInterval > 0)
+			GetGame().GetCallqueue().Remove(CheckFileChanged);
+
+		s_iWatchInterval = s_Instance.m_iConfigWatchInterval;
+
+		if (s_iWatchInterval > 0)
+			GetGame().GetCallqueue().CallLater(CheckFileChanged, s_iWatchInterval, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Periodic watcher - reload when the file contents differ from the last load
+	//------------------------------------------------------------------------------------------------
+	protected static void CheckFileChanged()
+	{
+		string contents = ReadFileContents(CONFIG_FILE_PATH);
+		if (contents.IsEmpty() || contents == s_sLastFileContents)
+			return;
+
+		Print("[IPC Extended] Configuration file changed - reloading");
+		Reload();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Read whole file as a string (empty if missing)
+	//------------------------------------------------------------------------------------------------
+	protected static string ReadFileContents(string path)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return string.Empty;
+
+		string contents;
+		string line;
+		while (file.ReadLine(line) >= 0)
+		{
+			contents += line + "\n";
+		}
+
+		file.Close();
+		return contents;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Clamp AI budget shares to 0-1 (max >= min) and scale minimums down if they exceed the limit
+	//------------------------------------------------------------------------------------------------
+	protected void SanitizeBudgetShares()
+	{
+		m_fBudgetDefenderMinShare = Math.Clamp(m_fBudgetDefenderMinShare, 0.0, 1.0);
+		m_fBudgetAttackerMinShare = Math.Clamp(m_fBudgetAttackerMinShare, 0.0, 1.0);
+		m_fBudgetReinforcementMinShare = Math.Clamp(m_fBudgetReinforcementMinShare, 0.0, 1.0);
+		m_fBudgetHelicopterMinShare = Math.Clamp(m_fBudgetHelicopterMinShare, 0.0, 1.0);
+
+		float minTotal = m_fBudgetDefenderMinShare + m_fBudgetAttackerMinShare + m_fBudgetReinforcementMinShare + m_fBudgetHelicopterMinShare;
+		if (minTotal > 1)
+		{
+			m_fBudgetDefenderMinShare /= minTotal;
+			m_fBudgetAttackerMinShare /= minTotal;
+			m_fBudgetReinforcementMinShare /= minTotal;
+			m_fBudgetHelicopterMinShare /= minTotal;
+		}
+
+		m_fBudgetDefenderMaxShare = Math.Clamp(m_fBudgetDefenderMaxShare, m_fBudgetDefenderMinShare, 1.0);
+		m_fBudgetAttackerMaxShare = Math.Clamp(m_fBudgetAttackerMaxShare, m_fBudgetAttackerMinShare, 1.0);
+		m_fBudgetReinforcementMaxShare = Math.Clamp(m_fBudgetReinforcementMaxShare, m_fBudgetReinforcementMinShare, 1.0);
+		m_fBudgetHelicopterMaxShare = Math.Clamp(m_fBudgetHelicopterMaxShare, m_fBudgetHelicopterMinShare, 1.0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Clamp values to safe ranges so a bad edit cannot stall or flood the server
+	//------------------------------------------------------------------------------------------------
+	protected void Sanitize()
+	{
+		m_iCheckInterval = Math.Max(m_iCheckInterval, 1000);
+		m_fCombatDetectionRange = Math.Max(m_fCombatDetectionRange, 10.0);
+		m_fWaveCooldown = Math.Max(m_fWaveCooldown, 0.0);
+
+		m_iDefenderRespawnTime = Math.Max(m_iDefenderRespawnTime, 10);
+		m_iDefenderGroupCount = Math.Max(m_iDefenderGroupCount, 0);
+		m_fIdleDefenderRange = Math.Max(m_fIdleDefenderRange, 100.0);
+		m_iAttackerRespawnTime = Math.Max(m_iAttackerRespawnTime, 10);
+		m_iAttackerGroupCount = Math.Max(m_iAttackerGroupCount, 0);
+		m_iAttackerSaturationCap = Math.Max(m_iAttackerSaturationCap, 1);
+		m_fAttackerSaturationRadius = Math.Max(m_fAttackerSaturationRadius, 10.0);
+		m_iDensityMapInterval = Math.Max(m_iDensityMapInterval, 500);
+		m_iPopulationTarget = Math.Max(m_iPopulationTarget, 1);
+		m_fPerceptionFullRange = Math.Max(m_fPerceptionFullRange, 0.0);
+		m_fPerceptionFarRange = Math.Max(m_fPerceptionFarRange, m_fPerceptionFullRange);
+		m_fPerceptionDensityRadius = Math.Max(m_fPerceptionDensityRadius, 10.0);
+		m_iPerceptionDenseCount = Math.Max(m_iPerceptionDenseCount, 1);
+		m_fPerceptionMinFactor = Math.Clamp(m_fPerceptionMinFactor, 0.1, 1.0);
+		m_iPerceptionGroupsPerTick = Math.Max(m_iPerceptionGroupsPerTick, 1);
+		m_fPopulationFrameBudgetMs = Math.Max(m_fPopulationFrameBudgetMs, 1.0);
+		m_iPopulationControlInterval = Math.Max(m_iPopulationControlInterval, 1000);
+		m_fPopulationGain = Math.Clamp(m_fPopulationGain, 0.0, 1.0);
+		m_fPopulationDamping = Math.Clamp(m_fPopulationDamping, 0.01, 1.0);
+		m_fPopulationMinScale = Math.Clamp(m_fPopulationMinScale, 0.05, 1.0);
+		m_fPopulationMaxScale = Math.Max(m_fPopulationMaxScale, 1.0);
+
+		m_iReinforcementGroupCount = Math.Max(m_iReinforcementGroupCount, 0);
+		m_fReinforcementSpawnRadius = Math.Max(m_fReinforcementSpawnRadius, 10.0);
+		m_fSpawnRingInnerRadius = Math.Max(m_fSpawnRingInnerRadius, 0.0);
+		m_iSpawnRingCandidates = Math.Max(m_iSpawnRingCandidates, 1);
+		m_iWaypointCandidates = Math.Max(m_iWaypointCandidates, 1);
+		m_iSpawnSlotsPerPosition = Math.Clamp(m_iSpawnSlotsPerPosition, 1, 32);
+		m_fSpawnSlotSpacing = Math.Max(m_fSpawnSlotSpacing, 1.0);
+		m_iRingValidationsPerFrame = Math.Max(m_iRingValidationsPerFrame, 1);
+		m_iTaskFrameBudgetMs = Math.Max(m_iTaskFrameBudgetMs, 1);
+
+		m_fSourceBaseMaxDistance = Math.Max(m_fSourceBaseMaxDistance, m_fSourceBaseMinDistance);
+		m_fRouteSampleSpacing = Math.Max(m_fRouteSampleSpacing, 50.0);
+		m_iWaypointStaggerMs = Math.Max(m_iWaypointStaggerMs, 0);
+
+		m_iDirectorWavesPerTick = Math.Max(m_iDirectorWavesPerTick, 0);
+		m_fDirectorConcentrateRatio = Math.Clamp(m_fDirectorConcentrateRatio, 0.0, 1.0);
+		m_iGroupCleanupInterval = Math.Max(m_iGroupCleanupInterval, 1000);
+		m_iFrontlineInterval = Math.Max(m_iFrontlineInterval, 1000);
+		m_iStuckWatchdogInterval = Math.Max(m_iStuckWatchdogInterval, 1000);
+		m_fStuckDistance = Math.Max(m_fStuckDistance, 1.0);
+		m_iCostLedgerWindow = Math.Clamp(m_iCostLedgerWindow, 60, 3600);
+		m_iCostLedgerTopBases = Math.Max(m_iCostLedgerTopBases, 1);
+		m_sDirectorMode.ToLower();
+		if (m_sDirectorMode != IPC_ReinforcementDirector.MODE_CONCENTRATE)
+			m_sDirectorMode = IPC_ReinforcementDirector.MODE_SPREAD;
+
+		m_iBudgetAgentsPerSpawnCall = Math.Max(m_iBudgetAgentsPerSpawnCall, 1);
+		m_iHelicopterCrewSize = Math.Max(m_iHelicopterCrewSize, 1);
+		SanitizeBudgetShares();
+
+		m_fHelicopterSpawnAltitude = Math.Max(m_fHelicopterSpawnAltitude, 50.0);
+		m_fHelicopterApproachSpeed = Math.Max(m_fHelicopterApproachSpeed, 1.0);
+		m_fHelicopterMaterializeDistance = Math.Max(m_fHelicopterMaterializeDistance, 0.0);
+		m_fHelicopterVisualRange = Math.Max(m_fHelicopterVisualRange, 0.0);
+
+		m_iInactiveGracePeriod = Math.Max(m_iInactiveGracePeriod, 0);
+
+		m_fPoolMaxPoints = Math.Max(m_fPoolMaxPoints, 0.0);
+		m_fPoolInitialPoints = Math.Clamp(m_fPoolInitialPoints, 0.0, m_fPoolMaxPoints);
+		m_fPoolRegenPerMinute = Math.Max(m_fPoolRegenPerMinute, 0.0);
+		m_fPoolRegenPerBasePerMinute = Math.Max(m_fPoolRegenPerBasePerMinute, 0.0);
+		m_iPoolCostFireteam = Math.Max(m_iPoolCostFireteam, 0);
+		m_iPoolCostSquad = Math.Max(m_iPoolCostSquad, 0);
+		m_iPoolCostHelicopter = Math.Max(m_iPoolCostHelicopter, 0);
+		m_fMetricsContactRange = Math.Max(m_fMetricsContactRange, 10.0);
+		m_fMetricsIdleRange = Math.Max(m_fMetricsIdleRange, m_fMetricsContactRange);
+		m_fCasualtyLifetime = Math.Max(m_fCasualtyLifetime, 0.0);
+		m_fCasualtyUnwatchedLifetime = Math.Clamp(m_fCasualtyUnwatchedLifetime, 0.0, m_fCasualtyLifetime);
+		m_fCasualtyPlayerRange = Math.Max(m_fCasualtyPlayerRange, 0.0);
+		m_iCasualtyEntityThreshold = Math.Max(m_iCasualtyEntityThreshold, 1);
+		if (!m_aLightLoadoutGroupTypes)
+			m_aLightLoadoutGroupTypes = {};
+		if (!m_aLightLoadoutGroupPrefabs)
+			m_aLightLoadoutGroupPrefabs = {};
+		m_fLightLoadoutAIRatio = Math.Clamp(m_fLightLoadoutAIRatio, 0.0, 1.0);
+		m_fLightLoadoutEntityRatio = Math.Max(m_fLightLoadoutEntityRatio, 0.0);
+		m_iLightLoadoutMagazines = Math.Max(m_iLightLoadoutMagazines, 0);
+		m_iLightLoadoutGrenades = Math.Max(m_iLightLoadoutGrenades, 0);
+		m_iOverlayUpdateInterval = Math.Max(m_iOverlayUpdateInterval, 500);
+		m_iDebugWaveInterval = Math.Max(m_iDebugWaveInterval, 10);
+
+		if (m_iConfigWatchInterval > 0)
+			m_iConfigWatchInterval = Math.Max(m_iConfigWatchInterval, 1000);
+
+		// Wave thresholds - always four entries, ascending
+		if (!m_aWaveThresholds)
+			m_aWaveThresholds = {};
+
+		array<int> defaults = {300, 600, 900, 1200};
+		for (int i = m_aWaveThresholds.Count(); i < defaults.Count(); i++)
+		{
+			m_aWaveThresholds.Insert(defaults[i]);
+		}
+
+		for (int i = 1; i < m_aWaveThresholds.Count(); i++)
+		{
+			m_aWaveThresholds[i] = Math.Max(m_aWaveThresholds[i], m_aWaveThresholds[i - 1]);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get combat duration (s) needed for a wave, 999999 if the wave does not exist
+	//------------------------------------------------------------------------------------------------
+	int GetWaveThreshold(int waveNumber)
+	{
+		if (m_bDebugMode)
+			return waveNumber * m_iDebugWaveInterval;
+
+		if (waveNumber < 1 || waveNumber > m_aWaveThresholds.Count())
+			return 999999; // Invalid wave
+
+		return m_aWaveThresholds[waveNumber - 1];
+	}
+}
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Deterministic Random Streams
+// Mod-owned random number generation for every spawn decision
+//
+// Each base gets its own stream seeded from m_iRandomSeed and the base position, so the
+// sequence of decisions at one base does not depend on activity at other bases.
+// With a fixed seed, two runs on the same map with the same inputs produce identical layouts.
+// m_iRandomSeed = 0 picks a new seed per session (printed to the log so a run can be repeated).
+//------------------------------------------------------------------------------------------------
+
+class IPC_ExtendedRandom
+{
+	protected static ref map<string, ref RandomGenerator> s_mStreams = new map<string, ref RandomGenerator>();
+	protected static int s_iConfiguredSeed;		// m_iRandomSeed the streams were created for
+	protected static int s_iSessionSeed;		// Resolved seed (never 0)
+
+	//------------------------------------------------------------------------------------------------
+	//! Get random stream for a base
+	//------------------------------------------------------------------------------------------------
+	static RandomGenerator GetBaseStream(notnull SCR_CampaignMilitaryBaseComponent base)
+	{
+		vector basePos = base.GetOwner().GetOrigin();
+		return GetStream(string.Format("base_%1_%2", Math.Round(basePos[0]), Math.Round(basePos[2])));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get (or create) a named random stream
+	//------------------------------------------------------------------------------------------------
+	static RandomGenerator GetStream(string key)
+	{
+		UpdateSeed();
+
+		RandomGenerator stream = s_mStreams.Get(key);
+		if (stream)
+			return stream;
+
+		stream = new RandomGenerator();
+		stream.SetSeed(s_iSessionSeed ^ key.Hash());
+		s_mStreams.Insert(key, stream);
+		return stream;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pick a random element index from a stream (-1 for an empty array)
+	//------------------------------------------------------------------------------------------------
+	static int RandomIndex(notnull RandomGenerator stream, int count)
+	{
+		if (count <= 0)
+			return -1;
+
+		return stream.RandInt(0, count);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pick a random position from a stream
+	//------------------------------------------------------------------------------------------------
+	static vector RandomPosition(notnull RandomGenerator stream, notnull array<vector> positions)
+	{
+		int index = RandomIndex(stream, positions.Count());
+		if (index < 0)
+			return vector.Zero;
+
+		return positions[index];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get seed in use for this session
+	//------------------------------------------------------------------------------------------------
+	static int GetSessionSeed()
+	{
+		UpdateSeed();
+		return s_iSessionSeed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Resolve the seed and restart all streams when the configured seed changed
+	//------------------------------------------------------------------------------------------------
+	protected static void UpdateSeed()
+	{
+		int configuredSeed = IPC_ExtendedConfig.GetInstance().m_iRandomSeed;
+		if (s_iSessionSeed != 0 && configuredSeed == s_iConfiguredSeed)
+			return;
+
+		s_iConfiguredSeed = configuredSeed;
+		s_iSessionSeed = configuredSeed;
+		if (s_iSessionSeed == 0)
+			s_iSessionSeed = Math.RandomIntInclusive(1, int.MAX);
+
+		s_mStreams.Clear();
+		PrintFormat("[IPC Extended] Random streams seeded with %1 (configured: %2)", s_iSessionSeed, configuredSeed);
+	}
+}
@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Stats Dump
+// Collects human-readable state from every addon subsystem
+// Shown by the admin command "#ipcext stats" and written to the server log
+//------------------------------------------------------------------------------------------------
+
+class IPC_ExtendedStats
+{
+	//------------------------------------------------------------------------------------------------
+	//! Collect stats lines from all subsystems
+	//------------------------------------------------------------------------------------------------
+	static void Collect(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Random seed: %1", IPC_ExtendedRandom.GetSessionSeed()));
+		IPC_ReinforcementDirector.GetInstance().GetStats(lines);
+		IPC_BaseChannelScheduler.GetInstance().GetStats(lines);
+		IPC_BaseCostLedger.GetInstance().GetStats(lines);
+		IPC_ReinforcementPool.GetInstance().GetStats(lines);
+		IPC_AIBudget.GetInstance().GetStats(lines);
+		IPC_AIDensityMap.GetInstance().GetStats(lines);
+		IPC_PopulationController.GetInstance().GetStats(lines);
+		IPC_PerceptionScaler.GetInstance().GetStats(lines);
+		IPC_DefenderPosture.GetInstance().GetStats(lines);
+		IPC_VirtualHelicopter.GetInstance().GetStats(lines);
+		IPC_WaveMetrics.GetInstance().GetStats(lines);
+		IPC_CasualtyCleanup.GetInstance().GetStats(lines);
+		IPC_LightLoadout.GetStats(lines);
+		IPC_SpawnRingCache.GetInstance().GetStats(lines);
+		IPC_FrontlineMap.GetInstance().GetStats(lines);
+		IPC_TaskRunner.GetInstance().GetStats(lines);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Print stats to the server log and return them as one string
+	//------------------------------------------------------------------------------------------------
+	static string Dump()
+	{
+		array<string> lines = {};
+		Collect(lines);
+
+		string result;
+		foreach (string line : lines)
+		{
+			PrintFormat("[IPC Extended] %1", line);
+			result += line + "\n";
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Frontline Map
+// Which factions hold a base within frontline range of each base, for any number of factions
+//
+// One pass over all base pairs records, per base, every faction in contact with it. The result
+// is cached per base and faction pair and only rebuilt when a base changes owner or the
+// frontline range is reloaded, so each target update is a few map lookups.
+//------------------------------------------------------------------------------------------------
+
+class IPC_FrontlineMap
+{
+	protected static ref IPC_FrontlineMap s_Instance;
+
+	protected ref set<string> m_Contacts = new set<string>();	// "<baseIdx>|<factionKey>" pairs in contact
+	protected string m_sOwnerSignature;							// Base owners the contacts were built from
+	protected float m_fRange = -1;								// Frontline range the contacts were built with
+	protected int m_iRebuilds;
+
+	//------------------------------------------------------------------------------------------------
+	//! Live instance (the trace replay uses its own)
+	//------------------------------------------------------------------------------------------------
+	static IPC_FrontlineMap GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_FrontlineMap();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Does a base have a base of any of the given factions within frontline range
+	//------------------------------------------------------------------------------------------------
+	bool HasContact(notnull IPC_CombatSnapshot snapshot, int baseIndex, notnull array<string> factionKeys)
+	{
+		Update(snapshot);
+
+		foreach (string factionKey : factionKeys)
+		{
+			if (m_Contacts.Contains(GetPairKey(baseIndex, factionKey)))
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Rebuild contacts if base ownership or the frontline range changed
+	//------------------------------------------------------------------------------------------------
+	protected void Update(IPC_CombatSnapshot snapshot)
+	{
+		float range = IPC_ExtendedConfig.GetInstance().m_fFrontlineRange;
+
+		string signature;
+		foreach (IPC_BaseSample base : snapshot.m_aBases)
+		{
+			signature += base.m_sFactionKey + ";";
+		}
+
+		if (signature == m_sOwnerSignature && range == m_fRange)
+			return;
+
+		m_sOwnerSignature = signature;
+		m_fRange = range;
+		m_iRebuilds++;
+		m_Contacts.Clear();
+
+		float rangeSq = range * range;
+		int count = snapshot.m_aBases.Count();
+
+		for (int i = 0; i < count; i++)
+		{
+			IPC_BaseSample baseA = snapshot.m_aBases[i];
+
+			for (int j = i + 1; j < count; j++)
+			{
+				IPC_BaseSample baseB = snapshot.m_aBases[j];
+				if (vector.DistanceSqXZ(baseA.m_vPosition, baseB.m_vPosition) >= rangeSq)
+					continue;
+
+				if (!baseB.m_sFactionKey.IsEmpty())
+					m_Contacts.Insert(GetPairKey(baseA.m_iIndex, baseB.m_sFactionKey));
+
+				if (!baseA.m_sFactionKey.IsEmpty())
+					m_Contacts.Insert(GetPairKey(baseB.m_iIndex, baseA.m_sFactionKey));
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static string GetPairKey(int baseIndex, string factionKey)
+	{
+		return baseIndex.ToString() + "|" + factionKey;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append frontline state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Frontline map: %1 base/faction contacts | %2 rebuilds", m_Contacts.Count(), m_iRebuilds));
+	}
+}
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Lightweight Loadout
+// Strips reinforcement soldiers down to a combat-essential kit while budgets are under pressure
+//
+// Used for group types listed in m_aLightLoadoutGroupTypes when the active AI count reaches
+// m_fLightLoadoutAIRatio of the AI world limit, or the tracked casualty entities reach
+// m_fLightLoadoutEntityRatio of m_iCasualtyEntityThreshold.
+//
+// The saving comes from m_aLightLoadoutGroupPrefabs: a light group prefab configured for the
+// faction and group type is spawned instead of the regular one, so the extra kit is never created
+// or replicated (the AI budget is estimated from that prefab). Without one, the regular group is
+// stripped after spawning: a soldier keeps their weapons, loaded magazines, m_iLightLoadoutMagazines
+// spare magazines and m_iLightLoadoutGrenades grenades; gadgets are removed. That fallback does
+// not save the spawn or its replication - it only means less inventory to carry and less loot left
+// on the bodies for the casualty cleanup.
+//------------------------------------------------------------------------------------------------
+
+class IPC_LightLoadout
+{
+	protected static int s_iLightGroups;
+	protected static int s_iLightPrefabGroups;
+	protected static int s_iRemovedItems;
+
+	//------------------------------------------------------------------------------------------------
+	//! Should a group of this type spawn with the light loadout right now
+	//------------------------------------------------------------------------------------------------
+	static bool ShouldUse(SCR_EGroupType groupType)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_aLightLoadoutGroupTypes.Contains(typename.EnumToString(SCR_EGroupType, groupType)))
+			return false;
+
+		AIWorld aiWorld = GetGame().GetAIWorld();
+		if (aiWorld && aiWorld.GetLimitOfActiveAIs() > 0
+			&& aiWorld.GetCurrentNumOfActiveAIs() >= config.m_fLightLoadoutAIRatio * aiWorld.GetLimitOfActiveAIs())
+			return true;
+
+		return IPC_CasualtyCleanup.GetInstance().GetPressure() >= config.m_fLightLoadoutEntityRatio;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Light group prefab configured for a faction and group type ("" = none, strip instead)
+	//------------------------------------------------------------------------------------------------
+	static ResourceName GetLightPrefab(string factionKey, SCR_EGroupType groupType)
+	{
+		string typeName = typename.EnumToString(SCR_EGroupType, groupType);
+
+		foreach (string entry : IPC_ExtendedConfig.GetInstance().m_aLightLoadoutGroupPrefabs)
+		{
+			array<string> parts = {};
+			entry.Split("|", parts, false);
+			if (parts.Count() == 3 && parts[0] == factionKey && parts[1] == typeName)
+				return parts[2];
+		}
+
+		return string.Empty;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Count a group spawned from a light group prefab
+	//------------------------------------------------------------------------------------------------
+	static void CountLightPrefabGroup()
+	{
+		s_iLightGroups++;
+		s_iLightPrefabGroups++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Strip every soldier of a freshly spawned group (no light prefab configured)
+	//------------------------------------------------------------------------------------------------
+	static void ApplyToGroup(notnull SCR_AIGroup group)
+	{
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+
+		int removed;
+		foreach (AIAgent agent : agents)
+		{
+			IEntity character = agent.GetControlledEntity();
+			if (character)
+				removed += Apply(character);
+		}
+
+		s_iLightGroups++;
+		s_iRemovedItems += removed;
+		PrintFormat("[IPC Reinforcement] Light loadout applied to %1 soldiers (%2 items removed)", agents.Count(), removed);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Remove spare magazines, grenades and gadgets above the light kit
+	//! \return number of removed items
+	//------------------------------------------------------------------------------------------------
+	protected static int Apply(IEntity character)
+	{
+		InventoryStorageManagerComponent storageManager = InventoryStorageManagerComponent.Cast(character.FindComponent(InventoryStorageManagerComponent));
+		if (!storageManager)
+			return 0;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		array<IEntity> items = {};
+		storageManager.GetItems(items);
+
+		int magazines;
+		int grenades;
+		int removed;
+
+		foreach (IEntity item : items)
+		{
+			if (!item)
+				continue;
+
+			bool remove;
+			if (item.FindComponent(MagazineComponent))
+			{
+				// Loaded magazines stay with their weapon
+				IEntity parent = item.GetParent();
+				if (parent && parent.FindComponent(WeaponComponent))
+					continue;
+
+				magazines++;
+				remove = magazines > config.m_iLightLoadoutMagazines;
+			}
+			else if (IsGrenade(item))
+			{
+				grenades++;
+				remove = grenades > config.m_iLightLoadoutGrenades;
+			}
+			else
+			{
+				remove = item.FindComponent(SCR_GadgetComponent) != null;
+			}
+
+			if (remove && storageManager.TryDeleteItem(item))
+				removed++;
+		}
+
+		return removed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static bool IsGrenade(IEntity item)
+	{
+		WeaponComponent weapon = WeaponComponent.Cast(item.FindComponent(WeaponComponent));
+		if (!weapon)
+			return false;
+
+		EWeaponType weaponType = weapon.GetWeaponType();
+		return weaponType == EWeaponType.WT_FRAGGRENADE || weaponType == EWeaponType.WT_SMOKEGRENADE;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append light loadout usage to a stats dump
+	//------------------------------------------------------------------------------------------------
+	static void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Light loadouts: %1 groups (%2 from light prefabs) | %3 items stripped", s_iLightGroups, s_iLightPrefabGroups, s_iRemovedItems));
+	}
+}
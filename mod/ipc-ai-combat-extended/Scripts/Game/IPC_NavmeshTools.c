@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Navmesh Tools
+// Reachability checks against the soldier navmesh
+// Used to reject spawn/waypoint positions inside fenced compounds or on islands
+//------------------------------------------------------------------------------------------------
+
+class IPC_NavmeshTools
+{
+	protected static const string NAVMESH_NAME = "Soldiers";
+	protected static const vector SNAP_EXTENTS = "3 5 3";		// Search box for the closest navmesh point
+	protected static const float PATH_END_TOLERANCE = 3.0;		// Max gap between path end and target (m)
+
+	//------------------------------------------------------------------------------------------------
+	//! Get soldier navmesh (null if the world has none)
+	//------------------------------------------------------------------------------------------------
+	static NavmeshWorldComponent GetNavmesh()
+	{
+		SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
+		if (!aiWorld)
+			return null;
+
+		return aiWorld.GetNavmeshWorldComponent(NAVMESH_NAME);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Check that a soldier can walk from one position to another
+	//! \param[out] snappedTo target position snapped onto the navmesh
+	//! \return true if both ends are on the navmesh and a complete path exists
+	//------------------------------------------------------------------------------------------------
+	static bool IsReachable(vector from, vector to, out vector snappedTo)
+	{
+		NavmeshWorldComponent navmesh = GetNavmesh();
+		if (!navmesh)
+		{
+			// No navmesh to test against - accept the position as-is
+			snappedTo = to;
+			return true;
+		}
+
+		vector snappedFrom;
+		if (!navmesh.GetReachablePoint(from, SNAP_EXTENTS, snappedFrom))
+			return false;
+
+		if (!navmesh.GetReachablePoint(to, SNAP_EXTENTS, snappedTo))
+			return false;
+
+		array<vector> path = {};
+		if (!navmesh.FindPath(snappedFrom, snappedTo, path) || path.IsEmpty())
+			return false;
+
+		// A partial path ends short of the target (different navmesh island)
+		return vector.Distance(path[path.Count() - 1], snappedTo) <= PATH_END_TOLERANCE;
+	}
+}
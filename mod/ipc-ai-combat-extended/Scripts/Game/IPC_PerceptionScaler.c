@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Perception Scaler
+// Lowers perception (and skill) of reinforcement groups that sit in dense clusters far from players
+//
+// Registered groups are revisited round-robin, m_iPerceptionGroupsPerTick per second, so the
+// cost does not grow per agent per frame. For each group the reduction is
+//   distance weight (0 within m_fPerceptionFullRange of the nearest alive player, 1 at
+//   m_fPerceptionFarRange) x density weight (other friendly AI within m_fPerceptionDensityRadius from
+//   IPC_AIDensityMap, 1 at m_iPerceptionDenseCount)
+// and perception = spawn perception x lerp(1, m_fPerceptionMinFactor, reduction). Groups reduced
+// by more than half also drop to VETERAN skill. Agents are only touched when the value changes.
+//
+// Lowering waits for the round-robin, raising does not: every tick, each reduced group gets a
+// distance-only check against the snapshot (no density query). When the nearest player alone
+// allows a higher factor than the applied one, the group is re-evaluated at once, so a player
+// walking up to a reduced cluster gets full perception back within one tick (TICK_INTERVAL).
+//------------------------------------------------------------------------------------------------
+
+class IPC_PerceptionGroup
+{
+	SCR_AIGroup m_Group;
+	string m_sFactionKey;
+	EAISkill m_eSkill;					// Skill and perception given at spawn
+	float m_fPerception;
+	float m_fAppliedFactor = 1;			// Share of the spawn perception currently applied
+}
+
+class IPC_PerceptionScaler
+{
+	protected static const int TICK_INTERVAL = 1000;		// ms
+	protected static const float APPLY_THRESHOLD = 0.05;	// Minimum factor change pushed to the agents
+
+	protected static ref IPC_PerceptionScaler s_Instance;
+
+	protected ref array<ref IPC_PerceptionGroup> m_aGroups = {};
+	protected int m_iNext;				// Round-robin cursor
+	protected bool m_bTicking;
+	protected int m_iUpdates;
+	protected int m_iFastChecks;		// Re-evaluations triggered by the per-tick check of reduced groups
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_PerceptionScaler GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_PerceptionScaler();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start scaling a group that was given this skill and perception at spawn
+	//------------------------------------------------------------------------------------------------
+	void Register(SCR_AIGroup group, EAISkill skill, float perception)
+	{
+		if (!group || !group.GetFaction() || !IPC_ExtendedConfig.GetInstance().m_bPerceptionScaling)
+			return;
+
+		IPC_PerceptionGroup entry = new IPC_PerceptionGroup();
+		entry.m_Group = group;
+		entry.m_sFactionKey = group.GetFaction().GetFactionKey();
+		entry.m_eSkill = skill;
+		entry.m_fPerception = perception;
+		m_aGroups.Insert(entry);
+
+		if (!m_bTicking)
+		{
+			m_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, TICK_INTERVAL, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Re-evaluate the next few groups
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		IPC_CombatSnapshot snapshot;
+
+		// Reduced groups: the nearest player bounds the reduction from above, density can only lower it further
+		foreach (IPC_PerceptionGroup reduced : m_aGroups)
+		{
+			if (reduced.m_fAppliedFactor >= 1 || !reduced.m_Group || reduced.m_Group.GetAgentsCount() == 0)
+				continue;
+
+			if (!snapshot)
+				snapshot = IPC_CombatSnapshot.Capture(false);
+
+			float maxFactor = Math.Lerp(1, config.m_fPerceptionMinFactor, GetDistanceWeight(GetGroupPosition(reduced.m_Group), snapshot, config));
+			if (maxFactor == 1 || maxFactor - reduced.m_fAppliedFactor >= APPLY_THRESHOLD)
+			{
+				m_iFastChecks++;
+				Evaluate(reduced, snapshot, config);
+			}
+		}
+
+		for (int step = 0; step < config.m_iPerceptionGroupsPerTick && !m_aGroups.IsEmpty(); step++)
+		{
+			if (m_iNext >= m_aGroups.Count())
+				m_iNext = 0;
+
+			IPC_PerceptionGroup entry = m_aGroups[m_iNext];
+			if (!entry.m_Group || entry.m_Group.GetAgentsCount() == 0)
+			{
+				m_aGroups.Remove(m_iNext);
+				continue;
+			}
+
+			if (!snapshot)
+				snapshot = IPC_CombatSnapshot.Capture(false);
+
+			Evaluate(entry, snapshot, config);
+			m_iNext++;
+		}
+
+		if (m_aGroups.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			m_bTicking = false;
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Evaluate(IPC_PerceptionGroup entry, IPC_CombatSnapshot snapshot, IPC_ExtendedConfig config)
+	{
+		vector groupPos = GetGroupPosition(entry.m_Group);
+		float distanceWeight = GetDistanceWeight(groupPos, snapshot, config);
+
+		float densityWeight = 0;
+		if (distanceWeight > 0)
+		{
+			// Other friendly AI around the group (the group itself is in the density map too)
+			int nearbyAgents = IPC_AIDensityMap.GetInstance().CountAgents(groupPos, entry.m_sFactionKey, config.m_fPerceptionDensityRadius);
+			nearbyAgents = Math.Max(nearbyAgents - entry.m_Group.GetAgentsCount(), 0);
+			densityWeight = Math.Clamp(nearbyAgents / (config.m_iPerceptionDenseCount * 1.0), 0, 1);
+		}
+
+		float reduction = distanceWeight * densityWeight;
+		float factor = Math.Lerp(1, config.m_fPerceptionMinFactor, reduction);
+
+		// Skip small changes, but always restore fully once a player is close
+		bool restore = factor == 1 && entry.m_fAppliedFactor != 1;
+		if (!restore && Math.AbsFloat(factor - entry.m_fAppliedFactor) < APPLY_THRESHOLD)
+			return;
+
+		entry.m_fAppliedFactor = factor;
+		m_iUpdates++;
+
+		EAISkill skill = entry.m_eSkill;
+		if (reduction > 0.5)
+			skill = EAISkill.VETERAN;
+
+		Apply(entry.m_Group, skill, entry.m_fPerception * factor);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected vector GetGroupPosition(SCR_AIGroup group)
+	{
+		IEntity leader = group.GetLeaderEntity();
+		if (leader)
+			return leader.GetOrigin();
+
+		return group.GetOrigin();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Distance weight from the nearest alive player (0 within full range, 1 at far range or no player)
+	//------------------------------------------------------------------------------------------------
+	protected float GetDistanceWeight(vector groupPos, IPC_CombatSnapshot snapshot, IPC_ExtendedConfig config)
+	{
+		float nearestSq = -1;
+		foreach (IPC_PlayerSample player : snapshot.m_aPlayers)
+		{
+			if (!player.m_bAlive)
+				continue;
+
+			float distSq = vector.DistanceSqXZ(player.m_vPosition, groupPos);
+			if (nearestSq < 0 || distSq < nearestSq)
+				nearestSq = distSq;
+		}
+
+		if (nearestSq < 0)
+			return 1;
+
+		float span = Math.Max(config.m_fPerceptionFarRange - config.m_fPerceptionFullRange, 1);
+		return Math.Clamp((Math.Sqrt(nearestSq) - config.m_fPerceptionFullRange) / span, 0, 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Apply(SCR_AIGroup group, EAISkill skill, float perception)
+	{
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+
+		foreach (AIAgent agent : agents)
+		{
+			IEntity agentEntity = agent.GetControlledEntity();
+			if (!agentEntity)
+				continue;
+
+			SCR_AIInfoComponent infoComponent = SCR_AIInfoComponent.Cast(agentEntity.FindComponent(SCR_AIInfoComponent));
+			if (!infoComponent)
+				continue;
+
+			SCR_AICombatComponent combatComponent = infoComponent.GetCombatComponent();
+			if (!combatComponent)
+				continue;
+
+			combatComponent.SetAISkill(skill);
+			combatComponent.SetPerceptionFactor(perception);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append scaler state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		int reduced;
+		foreach (IPC_PerceptionGroup entry : m_aGroups)
+		{
+			if (entry.m_fAppliedFactor < 1)
+				reduced++;
+		}
+
+		lines.Insert(string.Format("Perception scaling: %1 groups | %2 reduced | %3 updates (%4 early re-evaluations)", m_aGroups.Count(), reduced, m_iUpdates, m_iFastChecks));
+	}
+}
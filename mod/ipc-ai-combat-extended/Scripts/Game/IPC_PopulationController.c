@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Population Controller
+// Closed loop that scales spawn point respawn periods and group counts to a population target
+//
+// Every m_iPopulationControlInterval the controller compares the active AI count against
+// m_iPopulationTarget and the average server frame time against m_fPopulationFrameBudgetMs.
+// The tighter of the two relative errors moves the desired scale by m_fPopulationGain (bounded
+// by m_fPopulationMinScale..m_fPopulationMaxScale); the applied scale follows the desired one
+// with m_fPopulationDamping, so respawn rates change gradually instead of oscillating.
+// Spawn points read the scale in ApplyExtendedConfig(). The scale is a spawn rate (AI per minute)
+// factor, split evenly between its two inputs: respawn period / sqrt(scale), group count *
+// sqrt(scale). Applying it fully to both would move the rate by scale squared (0.25 -> 1/16).
+//------------------------------------------------------------------------------------------------
+
+class IPC_PopulationController
+{
+	protected static const float APPLY_THRESHOLD = 0.02;	// Minimum scale change pushed to the spawn points
+	protected static const int MIN_RESPAWN_PERIOD = 10;		// s
+
+	protected static ref IPC_PopulationController s_Instance;
+
+	protected int m_iScheduledInterval;
+	protected float m_fDesiredScale = 1;
+	protected float m_fAppliedScale = 1;
+	protected float m_fPushedScale = 1;
+	protected float m_fInputScale = 1;		// sqrt(m_fAppliedScale) - applied to period and count each
+
+	// Frame time measurement between two ticks
+	protected int m_iFrames;
+	protected int m_iWindowStart;
+	protected float m_fLastFrameMs;
+	protected int m_iLastActiveAI;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_PopulationController GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_PopulationController();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start, stop or reschedule the control loop after a config (re)load
+	//------------------------------------------------------------------------------------------------
+	void UpdateSchedule()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		int interval;
+		if (config.m_bPopulationControl)
+			interval = config.m_iPopulationControlInterval;
+
+		if (interval == m_iScheduledInterval)
+			return;
+
+		if (m_iScheduledInterval > 0)
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			GetGame().GetCallqueue().Remove(CountFrame);
+		}
+
+		m_iScheduledInterval = interval;
+
+		if (interval > 0)
+		{
+			ResetWindow();
+			GetGame().GetCallqueue().CallLater(Tick, interval, true);
+			GetGame().GetCallqueue().CallLater(CountFrame, 0, true);
+			return;
+		}
+
+		// Disabled - spawn points fall back to the configured constants
+		m_fDesiredScale = 1;
+		m_fAppliedScale = 1;
+		m_fPushedScale = 1;
+		m_fInputScale = 1;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Respawn period for a configured base period (s)
+	//------------------------------------------------------------------------------------------------
+	int ScaleRespawnPeriod(int period)
+	{
+		return Math.Max(Math.Round(period / m_fInputScale), MIN_RESPAWN_PERIOD);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Group count (SpawnUnits() calls) for a configured base count - a non-zero count stays at least 1
+	//------------------------------------------------------------------------------------------------
+	int ScaleGroupCount(int count)
+	{
+		if (count <= 0)
+			return count;
+
+		return Math.Max(Math.Round(count * m_fInputScale), 1);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void CountFrame()
+	{
+		m_iFrames++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void ResetWindow()
+	{
+		m_iFrames = 0;
+		m_iWindowStart = IPC_ScriptTimer.Start();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Measure, update the scale and push it to the spawn points when it moved enough
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		if (m_iFrames > 0)
+			m_fLastFrameMs = (startTick - m_iWindowStart) / (m_iFrames * 1.0);
+
+		ResetWindow();
+
+		AIWorld aiWorld = GetGame().GetAIWorld();
+		if (aiWorld)
+			m_iLastActiveAI = aiWorld.GetCurrentNumOfActiveAIs();
+
+		// Relative headroom: positive = room to spawn more, negative = over target
+		float populationError = (config.m_iPopulationTarget - m_iLastActiveAI) / (config.m_iPopulationTarget * 1.0);
+		float error = populationError;
+		if (m_fLastFrameMs > 0)
+		{
+			float frameError = (config.m_fPopulationFrameBudgetMs - m_fLastFrameMs) / config.m_fPopulationFrameBudgetMs;
+			error = Math.Min(populationError, frameError);
+		}
+
+		error = Math.Clamp(error, -1, 1);
+		m_fDesiredScale = Math.Clamp(m_fDesiredScale * (1 + config.m_fPopulationGain * error), config.m_fPopulationMinScale, config.m_fPopulationMaxScale);
+		m_fAppliedScale += config.m_fPopulationDamping * (m_fDesiredScale - m_fAppliedScale);
+
+		if (Math.AbsFloat(m_fAppliedScale - m_fPushedScale) >= APPLY_THRESHOLD)
+		{
+			m_fPushedScale = m_fAppliedScale;
+			m_fInputScale = Math.Sqrt(m_fAppliedScale);
+			IPC_ExtendedConfig.ApplyToSpawnPoints();
+
+			if (config.m_bDebugMode)
+				PrintFormat("[IPC Extended] Population scale %1 (AI %2/%3, frame %4 ms/%5 ms)", m_fAppliedScale, m_iLastActiveAI,
+							config.m_iPopulationTarget, m_fLastFrameMs, config.m_fPopulationFrameBudgetMs);
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append controller state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_bPopulationControl)
+		{
+			lines.Insert("Population controller: disabled");
+			return;
+		}
+
+		lines.Insert(string.Format("Population controller: scale %1 (desired %2) | AI %3/%4 | frame %5 ms (budget %6 ms)",
+			m_fAppliedScale.ToString(-1, 2), m_fDesiredScale.ToString(-1, 2), m_iLastActiveAI, config.m_iPopulationTarget,
+			m_fLastFrameMs.ToString(-1, 1), config.m_fPopulationFrameBudgetMs));
+	}
+}
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Proximity Sweep
+// Batch evaluation of every base against every player of one combat snapshot
+//
+// Alive players and bases are sorted along X once, then swept together: each base only looks at
+// the players inside its [x - range, x + range] window for the attacker count, and expands from
+// its own X position outwards for the nearest player until the X gap exceeds the best distance.
+// Sorting costs B log B + P log P and the window bounds only move forward. The per-base scans are
+// not bounded by that: the attacker window visits every player within range along X, and the
+// nearest player expansion visits every player closer along X than the nearest one found so far,
+// up to all P when the players are far away or spread in a band along Z. The worst case is still
+// B x P, the same as one loop over all players per base; the sweep only pays off while players
+// are clustered near a few bases, which is the usual combat picture. Distances are measured on
+// the ground plane (XZ) so replayed traces match the live server.
+//------------------------------------------------------------------------------------------------
+
+class IPC_BaseProximity
+{
+	int m_iAttackers;						// Alive players of another faction than the owner within range
+	float m_fNearestPlayerDistance = -1;	// Nearest alive player of any faction (-1 = no player)
+}
+
+class IPC_SweepPoint
+{
+	float m_fX;
+	float m_fZ;
+	string m_sFactionKey;
+	int m_iBaseIndex;						// Bases only
+}
+
+class IPC_ProximitySweep
+{
+	//------------------------------------------------------------------------------------------------
+	//! Evaluate all bases of a snapshot (keyed by IPC_BaseSample.m_iIndex)
+	//------------------------------------------------------------------------------------------------
+	static map<int, ref IPC_BaseProximity> Evaluate(notnull IPC_CombatSnapshot snapshot, float range)
+	{
+		map<int, ref IPC_BaseProximity> results = new map<int, ref IPC_BaseProximity>();
+
+		array<ref IPC_SweepPoint> players = {};
+		foreach (IPC_PlayerSample playerSample : snapshot.m_aPlayers)
+		{
+			if (playerSample.m_bAlive)
+				players.Insert(CreatePoint(playerSample.m_vPosition, playerSample.m_sFactionKey, -1));
+		}
+
+		array<ref IPC_SweepPoint> bases = {};
+		foreach (IPC_BaseSample baseSample : snapshot.m_aBases)
+		{
+			bases.Insert(CreatePoint(baseSample.m_vPosition, baseSample.m_sFactionKey, baseSample.m_iIndex));
+		}
+
+		SortByX(players);
+		SortByX(bases);
+
+		float rangeSq = range * range;
+		int windowStart;		// First player with x >= base x - range
+		int split;				// First player with x >= base x
+
+		foreach (IPC_SweepPoint base : bases)
+		{
+			IPC_BaseProximity result = new IPC_BaseProximity();
+			results.Insert(base.m_iBaseIndex, result);
+
+			while (windowStart < players.Count() && players[windowStart].m_fX < base.m_fX - range)
+				windowStart++;
+
+			while (split < players.Count() && players[split].m_fX < base.m_fX)
+				split++;
+
+			// Attackers: only players inside the X window
+			for (int i = windowStart; i < players.Count() && players[i].m_fX <= base.m_fX + range; i++)
+			{
+				IPC_SweepPoint player = players[i];
+				if (player.m_sFactionKey.IsEmpty() || player.m_sFactionKey == base.m_sFactionKey)
+					continue;
+
+				if (GetDistanceSq(player, base) < rangeSq)
+					result.m_iAttackers++;
+			}
+
+			// Nearest player: expand both ways from the base X until the X gap alone is too large
+			float bestSq = -1;
+			for (int left = split - 1; left >= 0; left--)
+			{
+				float gapLeft = base.m_fX - players[left].m_fX;
+				if (bestSq >= 0 && gapLeft * gapLeft >= bestSq)
+					break;
+
+				float distLeftSq = GetDistanceSq(players[left], base);
+				if (bestSq < 0 || distLeftSq < bestSq)
+					bestSq = distLeftSq;
+			}
+
+			for (int right = split; right < players.Count(); right++)
+			{
+				float gapRight = players[right].m_fX - base.m_fX;
+				if (bestSq >= 0 && gapRight * gapRight >= bestSq)
+					break;
+
+				float distRightSq = GetDistanceSq(players[right], base);
+				if (bestSq < 0 || distRightSq < bestSq)
+					bestSq = distRightSq;
+			}
+
+			if (bestSq >= 0)
+				result.m_fNearestPlayerDistance = Math.Sqrt(bestSq);
+		}
+
+		return results;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static IPC_SweepPoint CreatePoint(vector position, string factionKey, int baseIndex)
+	{
+		IPC_SweepPoint point = new IPC_SweepPoint();
+		point.m_fX = position[0];
+		point.m_fZ = position[2];
+		point.m_sFactionKey = factionKey;
+		point.m_iBaseIndex = baseIndex;
+		return point;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static float GetDistanceSq(IPC_SweepPoint a, IPC_SweepPoint b)
+	{
+		float dx = a.m_fX - b.m_fX;
+		float dz = a.m_fZ - b.m_fZ;
+		return dx * dx + dz * dz;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! In-place heap sort by X (script arrays of objects have no comparator sort)
+	//------------------------------------------------------------------------------------------------
+	protected static void SortByX(notnull array<ref IPC_SweepPoint> points)
+	{
+		int count = points.Count();
+
+		for (int start = count / 2 - 1; start >= 0; start--)
+		{
+			SiftDown(points, start, count);
+		}
+
+		for (int end = count - 1; end > 0; end--)
+		{
+			points.SwapItems(0, end);
+			SiftDown(points, 0, end);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void SiftDown(notnull array<ref IPC_SweepPoint> points, int root, int count)
+	{
+		while (true)
+		{
+			int largest = root;
+			int left = 2 * root + 1;
+			int right = left + 1;
+
+			if (left < count && points[left].m_fX > points[largest].m_fX)
+				largest = left;
+
+			if (right < count && points[right].m_fX > points[largest].m_fX)
+				largest = right;
+
+			if (largest == root)
+				return;
+
+			points.SwapItems(root, largest);
+			root = largest;
+		}
+	}
+}
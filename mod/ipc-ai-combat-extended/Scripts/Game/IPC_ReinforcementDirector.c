@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Reinforcement Director
+// Faction-level scheduler that decides which engaged bases get a reinforcement wave each tick
+//
+// Coordinators no longer run their own timers: the director ticks every m_iCheckInterval,
+// captures one shared snapshot, lets every coordinator update its wave ladder and collects the
+// waves that are due. Per faction at most m_iDirectorWavesPerTick waves are granted, highest
+// threat first (attackers in detection range + requested wave). Only waves that actually spawn
+// use up the budget - one the pool or AI budget refuses lets the next base try. Waves that are not
+// granted or did not spawn stay due and are requested again next tick.
+//
+// Modes (m_sDirectorMode):
+//   spread      - one wave per base in threat order until the budget is spent
+//   concentrate - only bases with at least m_fDirectorConcentrateRatio of the top threat
+//------------------------------------------------------------------------------------------------
+
+class IPC_WaveRequest
+{
+	IPC_DefenderSpawnPointComponent m_Coordinator;
+	int m_iWave;
+	float m_fThreat;
+}
+
+class IPC_ReinforcementDirector
+{
+	static const string MODE_SPREAD = "spread";
+	static const string MODE_CONCENTRATE = "concentrate";
+
+	protected static ref IPC_ReinforcementDirector s_Instance;
+
+	protected ref array<IPC_DefenderSpawnPointComponent> m_aCoordinators = {};
+	protected int m_iScheduledInterval;					// Tick interval currently queued (0 = none)
+
+	// Stats
+	protected int m_iTicks;
+	protected int m_iLastEngaged;						// Bases with a due wave in the last tick
+	protected int m_iWavesGranted;
+	protected int m_iWavesHeld;							// Due waves held back by the budget (summed over ticks)
+	protected int m_iWavesFailed;						// Granted waves that did not spawn (pool, AI budget, spawn errors)
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_ReinforcementDirector GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_ReinforcementDirector();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add a base coordinator to the central schedule
+	//------------------------------------------------------------------------------------------------
+	void Register(notnull IPC_DefenderSpawnPointComponent coordinator)
+	{
+		if (!m_aCoordinators.Contains(coordinator))
+			m_aCoordinators.Insert(coordinator);
+
+		Schedule(IPC_ExtendedConfig.GetInstance().m_iCheckInterval);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Unregister(IPC_DefenderSpawnPointComponent coordinator)
+	{
+		m_aCoordinators.RemoveItem(coordinator);
+
+		if (m_aCoordinators.IsEmpty())
+			Schedule(0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! (Re)schedule the director tick (0 = stop)
+	//------------------------------------------------------------------------------------------------
+	protected void Schedule(int interval)
+	{
+		if (interval == m_iScheduledInterval)
+			return;
+
+		if (m_iScheduledInterval > 0)
+			GetGame().GetCallqueue().Remove(Tick);
+
+		m_iScheduledInterval = interval;
+
+		if (interval > 0)
+			GetGame().GetCallqueue().CallLater(Tick, interval, true);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Evaluate every coordinator on one snapshot, then grant due waves per faction
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+		m_iTicks++;
+
+		// Bases are always captured - combat detection and threat come from one proximity sweep over all bases
+		IPC_CombatSnapshot snapshot = IPC_CombatSnapshot.Capture(true);
+
+		// Collect due waves per defending faction
+		map<string, ref array<ref IPC_WaveRequest>> requestsByFaction = new map<string, ref array<ref IPC_WaveRequest>>();
+		m_iLastEngaged = 0;
+
+		for (int i = m_aCoordinators.Count() - 1; i >= 0; i--)
+		{
+			IPC_DefenderSpawnPointComponent coordinator = m_aCoordinators[i];
+			if (!coordinator)
+			{
+				m_aCoordinators.Remove(i);
+				continue;
+			}
+
+			int dueWave = coordinator.EvaluateReinforcements(snapshot);
+			if (dueWave <= 0 || !coordinator.GetDefenderFaction())
+				continue;
+
+			IPC_WaveRequest request = new IPC_WaveRequest();
+			request.m_Coordinator = coordinator;
+			request.m_iWave = dueWave;
+			request.m_fThreat = coordinator.GetThreat(snapshot) + dueWave;
+
+			string factionKey = coordinator.GetDefenderFaction().GetFactionKey();
+			array<ref IPC_WaveRequest> requests = requestsByFaction.Get(factionKey);
+			if (!requests)
+			{
+				requests = {};
+				requestsByFaction.Insert(factionKey, requests);
+			}
+
+			InsertByThreat(requests, request);
+			m_iLastEngaged++;
+		}
+
+		foreach (string factionKey, array<ref IPC_WaveRequest> requests : requestsByFaction)
+		{
+			Allocate(factionKey, requests, snapshot);
+		}
+
+		// Idle / patrol transitions of defender groups from the same snapshot
+		IPC_DefenderPosture.GetInstance().Update(snapshot);
+
+		// Follow live config reloads
+		Schedule(IPC_ExtendedConfig.GetInstance().m_iCheckInterval);
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Keep requests sorted by descending threat
+	//------------------------------------------------------------------------------------------------
+	protected void InsertByThreat(notnull array<ref IPC_WaveRequest> requests, IPC_WaveRequest request)
+	{
+		foreach (int i, IPC_WaveRequest other : requests)
+		{
+			if (request.m_fThreat > other.m_fThreat)
+			{
+				requests.InsertAt(request, i);
+				return;
+			}
+		}
+
+		requests.Insert(request);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Grant waves of one faction within the per-tick budget
+	//------------------------------------------------------------------------------------------------
+	protected void Allocate(string factionKey, notnull array<ref IPC_WaveRequest> requests, IPC_CombatSnapshot snapshot)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		int budget = config.m_iDirectorWavesPerTick;
+
+		float minThreat = 0;
+		if (config.m_sDirectorMode == MODE_CONCENTRATE)
+			minThreat = requests[0].m_fThreat * config.m_fDirectorConcentrateRatio;
+
+		foreach (IPC_WaveRequest request : requests)
+		{
+			if (budget <= 0 || request.m_fThreat < minThreat)
+			{
+				m_iWavesHeld++;
+				PrintFormat("[IPC Reinforcement] Director holds WAVE %1 at %2 (%3, threat %4)",
+							request.m_iWave, request.m_Coordinator.GetNearBase().GetOwner().GetName(), factionKey, request.m_fThreat);
+				continue;
+			}
+
+			if (!request.m_Coordinator.TriggerReinforcements(request.m_iWave, snapshot))
+			{
+				m_iWavesFailed++;
+				continue;
+			}
+
+			budget--;
+			m_iWavesGranted++;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append director state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		lines.Insert(string.Format("Director (%1, %2 waves/tick): %3 coordinators | %4 ticks | %5 engaged last tick | %6 waves spawned | %7 held | %8 did not spawn",
+			config.m_sDirectorMode, config.m_iDirectorWavesPerTick, m_aCoordinators.Count(), m_iTicks, m_iLastEngaged, m_iWavesGranted, m_iWavesHeld, m_iWavesFailed));
+	}
+}
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Reinforcement Pool
+// Finite per-faction manpower pool that reinforcement waves draw from
+//
+// Each faction starts with m_fPoolInitialPoints and regenerates m_fPoolRegenPerMinute plus
+// m_fPoolRegenPerBasePerMinute for every base it holds, capped at m_fPoolMaxPoints.
+// A wave only fires when its full cost can be paid; otherwise it is deferred to a later check.
+// Total reinforcement AI is therefore bounded by pool size and regeneration rate.
+//------------------------------------------------------------------------------------------------
+
+class IPC_FactionReinforcementPool
+{
+	string m_sFactionKey;
+	float m_fPoints;				// Current manpower points
+	int m_iBasesHeld;				// Bases held at last regeneration tick
+	int m_iPointsSpent;				// Total points spent on waves
+	int m_iPointsRefunded;			// Points returned for failed spawns
+	int m_iWavesDeferred;			// Distinct waves deferred because the pool was too low
+	int m_iDeferredChecks;			// Payment attempts refused (a deferred wave retries every check)
+}
+
+class IPC_ReinforcementPool
+{
+	protected static const int REGEN_TICK_INTERVAL = 10000;	// Regeneration tick (ms)
+
+	protected static ref IPC_ReinforcementPool s_Instance;
+
+	protected ref map<string, ref IPC_FactionReinforcementPool> m_mPools = new map<string, ref IPC_FactionReinforcementPool>();
+
+	//------------------------------------------------------------------------------------------------
+	//! Get pool singleton (server only - starts the regeneration tick on first access)
+	//------------------------------------------------------------------------------------------------
+	static IPC_ReinforcementPool GetInstance()
+	{
+		if (!s_Instance)
+		{
+			s_Instance = new IPC_ReinforcementPool();
+			GetGame().GetCallqueue().CallLater(s_Instance.Regenerate, REGEN_TICK_INTERVAL, true);
+		}
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get (or create) pool for a faction
+	//------------------------------------------------------------------------------------------------
+	protected IPC_FactionReinforcementPool GetPool(Faction faction)
+	{
+		string factionKey = faction.GetFactionKey();
+
+		IPC_FactionReinforcementPool pool = m_mPools.Get(factionKey);
+		if (!pool)
+		{
+			pool = new IPC_FactionReinforcementPool();
+			pool.m_sFactionKey = factionKey;
+			pool.m_fPoints = IPC_ExtendedConfig.GetInstance().m_fPoolInitialPoints;
+			m_mPools.Insert(factionKey, pool);
+		}
+
+		return pool;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Try to pay for a wave - deducts the cost only if the whole amount is available
+	//! \param retry the same wave was already refused before (counted as a check, not as a new deferred wave)
+	//! \return true if the wave may spawn
+	//------------------------------------------------------------------------------------------------
+	bool TryConsume(Faction faction, int cost, bool retry = false)
+	{
+		if (!faction)
+			return false;
+
+		if (!IPC_ExtendedConfig.GetInstance().m_bPoolEnabled)
+			return true;
+
+		IPC_FactionReinforcementPool pool = GetPool(faction);
+		if (pool.m_fPoints < cost)
+		{
+			pool.m_iDeferredChecks++;
+			if (!retry)
+				pool.m_iWavesDeferred++;
+
+			return false;
+		}
+
+		pool.m_fPoints -= cost;
+		pool.m_iPointsSpent += cost;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Return points for groups that failed to spawn
+	//------------------------------------------------------------------------------------------------
+	void Refund(Faction faction, int cost)
+	{
+		if (!faction || cost <= 0)
+			return;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_bPoolEnabled)
+			return;
+
+		IPC_FactionReinforcementPool pool = GetPool(faction);
+		pool.m_fPoints = Math.Min(pool.m_fPoints + cost, config.m_fPoolMaxPoints);
+		pool.m_iPointsSpent -= cost;
+		pool.m_iPointsRefunded += cost;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get remaining points for a faction
+	//------------------------------------------------------------------------------------------------
+	float GetPoints(Faction faction)
+	{
+		if (!faction)
+			return 0;
+
+		return GetPool(faction).m_fPoints;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get pool cost of one reinforcement group
+	//------------------------------------------------------------------------------------------------
+	static int GetGroupCost(SCR_EGroupType groupType)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		if (groupType == SCR_EGroupType.FIRETEAM)
+			return config.m_iPoolCostFireteam;
+
+		return config.m_iPoolCostSquad;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Periodic regeneration (base rate + bonus per base held)
+	//------------------------------------------------------------------------------------------------
+	protected void Regenerate()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_bPoolEnabled || m_mPools.IsEmpty())
+			return;
+
+		SCR_CampaignMilitaryBaseManager baseManager;
+		SCR_GameModeCampaign gameMode = SCR_GameModeCampaign.GetInstance();
+		if (gameMode)
+			baseManager = gameMode.GetBaseManager();
+
+		FactionManager factionManager = GetGame().GetFactionManager();
+		float minutes = REGEN_TICK_INTERVAL / 60000.0;
+
+		foreach (string factionKey, IPC_FactionReinforcementPool pool : m_mPools)
+		{
+			pool.m_iBasesHeld = 0;
+
+			if (baseManager && factionManager)
+			{
+				Faction faction = factionManager.GetFactionByKey(factionKey);
+				if (faction)
+				{
+					array<SCR_CampaignMilitaryBaseComponent> bases = {};
+					baseManager.GetBases(bases, faction);
+					pool.m_iBasesHeld = bases.Count();
+				}
+			}
+
+			float regen = (config.m_fPoolRegenPerMinute + config.m_fPoolRegenPerBasePerMinute * pool.m_iBasesHeld) * minutes;
+			pool.m_fPoints = Math.Min(pool.m_fPoints + regen, config.m_fPoolMaxPoints);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append human-readable pool state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_bPoolEnabled)
+		{
+			lines.Insert("Reinforcement pool: disabled");
+			return;
+		}
+
+		foreach (string factionKey, IPC_FactionReinforcementPool pool : m_mPools)
+		{
+			lines.Insert(string.Format("Reinforcement pool %1: %2/%3 pts | bases held: %4 | spent: %5 | refunded: %6 | deferred waves: %7 (%8 checks)",
+				factionKey, Math.Floor(pool.m_fPoints), config.m_fPoolMaxPoints, pool.m_iBasesHeld,
+				pool.m_iPointsSpent, pool.m_iPointsRefunded, pool.m_iWavesDeferred, pool.m_iDeferredChecks));
+		}
+	}
+}
@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Reinforcement Tasks
+// Multi-frame reinforcement work run on IPC_TaskRunner
+//
+// Coordinator election and the wave alert wait on the runner instead of one-off CallLater
+// delays and are cancelled with their spawn point; wave despawn deletes one entity per step
+// instead of the whole previous wave in one frame. Waypoints of a wave's groups are assigned
+// one group at a time with a staggered delay, so their path requests do not land in one frame.
+//------------------------------------------------------------------------------------------------
+
+class IPC_CoordinatorElectionTask : IPC_Task
+{
+	protected static const int ELECTION_DELAY = 5000;	// ms - lets the other spawn points of the base call PrepareBase
+
+	protected IPC_DefenderSpawnPointComponent m_SpawnPoint;
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_CoordinatorElectionTask(notnull IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		m_SpawnPoint = spawnPoint;
+		SetOwner(spawnPoint);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		if (m_iState == 0)
+		{
+			m_iState = 1;
+			Sleep(ELECTION_DELAY);
+			return false;
+		}
+
+		m_SpawnPoint.InitializeReinforcementCoordinator();
+		return true;
+	}
+}
+
+class IPC_ReinforcementAlertTask : IPC_Task
+{
+	protected static const int ALERT_DELAY = 100;	// ms - avoids RPC timing issues right after the wave spawned
+
+	protected IPC_DefenderSpawnPointComponent m_SpawnPoint;
+	protected string m_sBaseName;
+	protected int m_iWave;
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_ReinforcementAlertTask(notnull IPC_DefenderSpawnPointComponent spawnPoint, string baseName, int wave)
+	{
+		m_SpawnPoint = spawnPoint;
+		SetOwner(spawnPoint);
+		m_sBaseName = baseName;
+		m_iWave = wave;
+		m_ePriority = IPC_ETaskPriority.HIGH;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		if (m_iState == 0)
+		{
+			m_iState = 1;
+			Sleep(ALERT_DELAY);
+			return false;
+		}
+
+		m_SpawnPoint.DoSendReinforcementAlert(m_sBaseName, m_iWave);
+		return true;
+	}
+}
+
+class IPC_WaypointAssignmentTask : IPC_Task
+{
+	protected IPC_DefenderSpawnPointComponent m_SpawnPoint;
+	protected SCR_AIGroup m_Group;
+	protected SCR_CampaignMilitaryBaseComponent m_SourceBase;
+	protected ref array<vector> m_aRoute;
+	protected int m_iDelay;
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_WaypointAssignmentTask(notnull IPC_DefenderSpawnPointComponent spawnPoint, SCR_AIGroup group, SCR_CampaignMilitaryBaseComponent sourceBase, array<vector> route, int delay)
+	{
+		m_SpawnPoint = spawnPoint;
+		SetOwner(spawnPoint);
+		m_Group = group;
+		m_SourceBase = sourceBase;
+		m_aRoute = route;
+		m_iDelay = delay;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		if (m_iState == 0 && m_iDelay > 0)
+		{
+			m_iState = 1;
+			Sleep(m_iDelay);
+			return false;
+		}
+
+		// Group wiped out while waiting
+		if (m_Group)
+		{
+			int startTick = IPC_ScriptTimer.Start();
+			m_SpawnPoint.CreateDefendWaypoint(m_Group, m_SourceBase, m_aRoute);
+			IPC_BaseCostLedger.Add(m_SpawnPoint.GetNearBase(), IPC_ECostCategory.WAYPOINTS, startTick);
+		}
+
+		return true;
+	}
+}
+
+class IPC_DespawnTask : IPC_Task
+{
+	protected ref array<IEntity> m_aEntities = {};
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_DespawnTask()
+	{
+		m_ePriority = IPC_ETaskPriority.LOW;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void AddEntity(IEntity entity)
+	{
+		if (entity)
+			m_aEntities.Insert(entity);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Delete one entity (skips ones already gone)
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		while (!m_aEntities.IsEmpty())
+		{
+			IEntity entity = m_aEntities[m_aEntities.Count() - 1];
+			m_aEntities.Remove(m_aEntities.Count() - 1);
+
+			if (entity && !entity.IsDeleted())
+			{
+				RplComponent.DeleteRplEntity(entity, false);
+				break;
+			}
+		}
+
+		return m_aEntities.IsEmpty();
+	}
+}
@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Route Cache
+// Road-snapped approach routes between base pairs, warmed once per map and reused for every wave
+//
+// This is not a path along the road network: script has no road graph search. A route is the
+// straight line between two bases, sampled every m_fRouteSampleSpacing, with each sample snapped to
+// the closest road point (RoadNetworkManager) within m_fRouteRoadSnapDistance. Samples without a
+// road nearby stay on the line, and the legs between samples are left to the AI's own pathfinding.
+// The result is a list of intermediate move positions (the destination itself is not included).
+//
+// Routes are warmed on the task runner while idle, one route per step: for every coordinator
+// base, from every base within m_fSourceBaseMinDistance..m_fSourceBaseMaxDistance of it (any owner
+// - bases change hands). Each source base also gets its ring cache candidates prepared. The wave
+// trigger path only looks routes up; a pair without a route is not used as a source base.
+//------------------------------------------------------------------------------------------------
+
+class IPC_RouteWarmupTask : IPC_Task
+{
+	//------------------------------------------------------------------------------------------------
+	void IPC_RouteWarmupTask()
+	{
+		m_ePriority = IPC_ETaskPriority.LOW;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		return IPC_RouteCache.GetInstance().WarmStep();
+	}
+}
+
+class IPC_RouteCache
+{
+	protected static ref IPC_RouteCache s_Instance;
+
+	protected ref map<string, ref array<vector>> m_mRoutes = new map<string, ref array<vector>>();
+	protected ref array<SCR_CampaignMilitaryBaseComponent> m_aDestinations = {};	// Coordinator bases routes are warmed for
+	protected ref array<SCR_CampaignMilitaryBaseComponent> m_aQueueFrom = {};		// Pending pairs, index-aligned
+	protected ref array<SCR_CampaignMilitaryBaseComponent> m_aQueueTo = {};
+	protected IPC_RouteWarmupTask m_WarmupTask;		// Queued on the task runner while warming
+	protected string m_sSettingsKey;				// Config values the cached routes were built with
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_RouteCache GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_RouteCache();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Warm the routes into a coordinator base in idle frames (only while m_bSpawnAtFriendlyBase is on)
+	//------------------------------------------------------------------------------------------------
+	void Prepare(notnull SCR_CampaignMilitaryBaseComponent toBase)
+	{
+		if (m_sSettingsKey.IsEmpty())
+			m_sSettingsKey = GetSettingsKey();
+
+		if (m_aDestinations.Contains(toBase))
+			return;
+
+		m_aDestinations.Insert(toBase);
+		if (IPC_ExtendedConfig.GetInstance().m_bSpawnAtFriendlyBase)
+			QueuePairs(toBase);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Drop routes built with other settings and warm every coordinator base again (config reload)
+	//------------------------------------------------------------------------------------------------
+	void OnConfigReloaded()
+	{
+		string settingsKey = GetSettingsKey();
+		if (settingsKey != m_sSettingsKey)
+		{
+			m_sSettingsKey = settingsKey;
+			m_mRoutes.Clear();
+			m_aQueueFrom.Clear();
+			m_aQueueTo.Clear();
+		}
+
+		if (!IPC_ExtendedConfig.GetInstance().m_bSpawnAtFriendlyBase)
+			return;
+
+		// Also picks up m_bSpawnAtFriendlyBase being switched on (known pairs are skipped)
+		foreach (SCR_CampaignMilitaryBaseComponent toBase : m_aDestinations)
+		{
+			if (toBase)
+				QueuePairs(toBase);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the cached route between two bases (lookup only - null if not warmed yet)
+	//------------------------------------------------------------------------------------------------
+	array<vector> GetRoute(notnull SCR_CampaignMilitaryBaseComponent fromBase, notnull SCR_CampaignMilitaryBaseComponent toBase)
+	{
+		return m_mRoutes.Get(GetKey(fromBase, toBase));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Compute one queued route and prepare the source base's spawn candidates (IPC_RouteWarmupTask)
+	//! \return true when the queue is empty
+	//------------------------------------------------------------------------------------------------
+	bool WarmStep()
+	{
+		if (!m_aQueueFrom.IsEmpty())
+		{
+			int last = m_aQueueFrom.Count() - 1;
+			SCR_CampaignMilitaryBaseComponent fromBase = m_aQueueFrom[last];
+			SCR_CampaignMilitaryBaseComponent toBase = m_aQueueTo[last];
+			m_aQueueFrom.Remove(last);
+			m_aQueueTo.Remove(last);
+
+			if (fromBase && toBase && !m_mRoutes.Contains(GetKey(fromBase, toBase)))
+			{
+				array<vector> route = ComputeRoute(fromBase.GetOwner().GetOrigin(), toBase.GetOwner().GetOrigin());
+				m_mRoutes.Insert(GetKey(fromBase, toBase), route);
+				IPC_SpawnRingCache.GetInstance().Prepare(fromBase);
+
+				PrintFormat("[IPC Reinforcement] Cached road-snapped route %1 -> %2 (%3 points)",
+							fromBase.GetOwner().GetName(), toBase.GetOwner().GetName(), route.Count());
+			}
+		}
+
+		if (!m_aQueueFrom.IsEmpty())
+			return false;
+
+		m_WarmupTask = null;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Queue every base in source range of a destination whose route is not cached yet
+	//------------------------------------------------------------------------------------------------
+	protected void QueuePairs(SCR_CampaignMilitaryBaseComponent toBase)
+	{
+		SCR_GameModeCampaign gameMode = SCR_GameModeCampaign.GetInstance();
+		if (!gameMode || !gameMode.GetBaseManager())
+			return;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		vector toPos = toBase.GetOwner().GetOrigin();
+
+		array<SCR_CampaignMilitaryBaseComponent> bases = {};
+		gameMode.GetBaseManager().GetBases(bases);
+
+		foreach (SCR_CampaignMilitaryBaseComponent fromBase : bases)
+		{
+			if (fromBase == toBase || m_mRoutes.Contains(GetKey(fromBase, toBase)))
+				continue;
+
+			float distance = vector.Distance(fromBase.GetOwner().GetOrigin(), toPos);
+			if (distance < config.m_fSourceBaseMinDistance || distance > config.m_fSourceBaseMaxDistance)
+				continue;
+
+			m_aQueueFrom.Insert(fromBase);
+			m_aQueueTo.Insert(toBase);
+		}
+
+		if (!m_aQueueFrom.IsEmpty() && !m_WarmupTask)
+		{
+			m_WarmupTask = new IPC_RouteWarmupTask();
+			IPC_TaskRunner.GetInstance().Add(m_WarmupTask);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected string GetKey(SCR_CampaignMilitaryBaseComponent fromBase, SCR_CampaignMilitaryBaseComponent toBase)
+	{
+		return string.Format("%1>%2", fromBase.GetOwner().GetID(), toBase.GetOwner().GetID());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Config values that shape the cached routes and the pairs worth warming
+	//------------------------------------------------------------------------------------------------
+	protected string GetSettingsKey()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		return string.Format("%1|%2|%3|%4", config.m_fRouteSampleSpacing, config.m_fRouteRoadSnapDistance,
+			config.m_fSourceBaseMinDistance, config.m_fSourceBaseMaxDistance);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of route pairs still waiting to be computed
+	//------------------------------------------------------------------------------------------------
+	int GetPendingCount()
+	{
+		return m_aQueueFrom.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of cached routes
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_mRoutes.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build a route from evenly spaced line samples, each snapped to the closest road point
+	//------------------------------------------------------------------------------------------------
+	protected array<vector> ComputeRoute(vector fromPos, vector toPos)
+	{
+		array<vector> route = {};
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		float spacing = config.m_fRouteSampleSpacing;
+		float totalDistance = vector.DistanceXZ(fromPos, toPos);
+		int sampleCount = Math.Floor(totalDistance / spacing);
+
+		RoadNetworkManager roadNetworkManager;
+		SCR_AIWorld aiWorld = SCR_AIWorld.Cast(GetGame().GetAIWorld());
+		if (aiWorld)
+			roadNetworkManager = aiWorld.GetRoadNetworkManager();
+
+		BaseWorld world = GetGame().GetWorld();
+
+		// Skip first sample (source base) - last sample is replaced by the defend waypoint
+		for (int i = 1; i < sampleCount; i++)
+		{
+			float t = i;
+			vector samplePos = vector.Lerp(fromPos, toPos, t / sampleCount);
+
+			vector roadPos;
+			if (roadNetworkManager && FindClosestRoadPoint(roadNetworkManager, samplePos, config.m_fRouteRoadSnapDistance, roadPos))
+				samplePos = roadPos;
+
+			samplePos[1] = world.GetSurfaceY(samplePos[0], samplePos[2]);
+
+			// Neighbouring samples often snap to the same road point
+			if (!route.IsEmpty() && vector.DistanceSqXZ(route[route.Count() - 1], samplePos) < 25 * 25)
+				continue;
+
+			route.Insert(samplePos);
+		}
+
+		return route;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Find closest road point within max distance
+	//------------------------------------------------------------------------------------------------
+	protected bool FindClosestRoadPoint(RoadNetworkManager roadNetworkManager, vector pos, float maxDistance, out vector roadPos)
+	{
+		BaseRoad road;
+		float roadDistance;
+		roadNetworkManager.GetClosestRoad(pos, road, roadDistance);
+		if (!road || roadDistance > maxDistance)
+			return false;
+
+		array<vector> points = {};
+		road.GetPoints(points);
+		if (points.IsEmpty())
+			return false;
+
+		float bestDistSq = float.MAX;
+		foreach (vector point : points)
+		{
+			float distSq = vector.DistanceSqXZ(point, pos);
+			if (distSq < bestDistSq)
+			{
+				bestDistSq = distSq;
+				roadPos = point;
+			}
+		}
+
+		return bestDistSq <= maxDistance * maxDistance;
+	}
+}
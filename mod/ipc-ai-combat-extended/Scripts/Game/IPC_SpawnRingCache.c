@@ -0,0 +1,504 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Spawn Ring Cache
+// Per-base cache of spawn and waypoint positions verified as clear and navmesh-reachable
+//
+// Candidates are generated on a ring around the base (spawn), close to the base (waypoint) and
+// close to the base for waves sourced from it (source). They are validated incrementally while
+// idle on the task runner, one world query per step (at most m_iRingValidationsPerFrame per
+// frame): a callback-based sphere query for blocking entities, then a navmesh path from the base
+// on a later step. Wave triggers only read the cached results and
+// never query the world - until a base is validated they get an unvalidated candidate.
+//
+// Every valid unit spawn position (ring and source) also gets m_iSpawnSlotsPerPosition
+// formation slots around it, m_fSpawnSlotSpacing apart, each checked with a character-sized
+// sphere query and then a navmesh path from that position (stored snapped onto the navmesh), so
+// the units of a group can be spread out instead of spawning in one pile or behind a fence.
+//
+// A config reload that changes ring radii, candidate counts or slot settings drops every base's
+// results and queues the regenerated candidates for validation again.
+//------------------------------------------------------------------------------------------------
+
+class IPC_CandidateSet
+{
+	float m_fClearance;							// Sphere query radius (m)
+	ref array<vector> m_aGenerated = {};		// All candidates (unvalidated fallback)
+	ref array<vector> m_aPending = {};			// Waiting for the sphere query
+	ref array<vector> m_aClear = {};			// Passed the sphere query, waiting for the navmesh check
+	ref array<vector> m_aValid = {};
+	int m_iRejected;
+
+	// Formation slots of the valid positions (unit sets only), indexed like m_aValid
+	bool m_bHasSlots;
+	ref array<ref array<vector>> m_aSlots = {};
+	ref array<vector> m_aSlotPending = {};		// Waiting for the sphere query
+	ref array<int> m_aSlotPendingAnchor = {};	// m_aValid index of each pending slot
+	ref array<vector> m_aSlotClear = {};		// Passed the sphere query, waiting for the navmesh check
+	ref array<int> m_aSlotClearAnchor = {};		// m_aValid index of each clear slot
+
+	//------------------------------------------------------------------------------------------------
+	bool HasPending()
+	{
+		return !m_aPending.IsEmpty() || !m_aClear.IsEmpty() || !m_aSlotPending.IsEmpty() || !m_aSlotClear.IsEmpty();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetPendingCount()
+	{
+		return m_aPending.Count() + m_aClear.Count() + m_aSlotPending.Count() + m_aSlotClear.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetSlotCount()
+	{
+		int count;
+		foreach (array<vector> slots : m_aSlots)
+		{
+			count += slots.Count();
+		}
+
+		return count;
+	}
+}
+
+class IPC_BaseSpawnCandidates
+{
+	vector m_vBasePos;
+	string m_sBaseName;
+	ref IPC_CandidateSet m_Spawn = new IPC_CandidateSet();
+	ref IPC_CandidateSet m_Waypoint = new IPC_CandidateSet();
+	ref IPC_CandidateSet m_Source = new IPC_CandidateSet();
+
+	//------------------------------------------------------------------------------------------------
+	bool HasPending()
+	{
+		return m_Spawn.HasPending() || m_Waypoint.HasPending() || m_Source.HasPending();
+	}
+}
+
+class IPC_RingValidationTask : IPC_Task
+{
+	//------------------------------------------------------------------------------------------------
+	void IPC_RingValidationTask()
+	{
+		m_ePriority = IPC_ETaskPriority.LOW;
+		m_iMaxStepsPerFrame = IPC_ExtendedConfig.GetInstance().m_iRingValidationsPerFrame;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		return IPC_SpawnRingCache.GetInstance().ProcessStep();
+	}
+}
+
+class IPC_SpawnRingCache
+{
+	protected static const float GOLDEN_ANGLE = 137.50776;		// Even angular spread for spiral sampling (deg)
+	protected static const float UNIT_CLEARANCE = 2.0;			// Sphere radius kept free for spawned units (m)
+	protected static const float WAYPOINT_CLEARANCE = 1.0;		// Sphere radius kept free for waypoints (m)
+	protected static const float SLOT_CLEARANCE = 0.6;			// Sphere radius kept free for one character (m)
+	protected static const float ANCHOR_TOLERANCE_SQ = 0.01;	// Max squared distance to match a picked position to its anchor
+
+	protected static ref IPC_SpawnRingCache s_Instance;
+
+	protected ref map<SCR_CampaignMilitaryBaseComponent, ref IPC_BaseSpawnCandidates> m_mBases = new map<SCR_CampaignMilitaryBaseComponent, ref IPC_BaseSpawnCandidates>();
+	protected ref array<ref IPC_BaseSpawnCandidates> m_aValidationQueue = {};
+	protected IPC_RingValidationTask m_ValidationTask;	// Queued on the task runner while validating
+	protected bool m_bClearanceBlocked;		// Set by the sphere query callback
+	protected string m_sGenerationKey;		// Config values the current candidates were generated with
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_SpawnRingCache GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_SpawnRingCache();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Generate candidates for a base and queue them for idle-frame validation (no-op if known)
+	//------------------------------------------------------------------------------------------------
+	IPC_BaseSpawnCandidates Prepare(notnull SCR_CampaignMilitaryBaseComponent base)
+	{
+		IPC_BaseSpawnCandidates candidates = m_mBases.Get(base);
+		if (candidates)
+			return candidates;
+
+		if (m_sGenerationKey.IsEmpty())
+			m_sGenerationKey = GetGenerationKey();
+
+		candidates = new IPC_BaseSpawnCandidates();
+		candidates.m_vBasePos = base.GetOwner().GetOrigin();
+		candidates.m_sBaseName = base.GetOwner().GetName();
+		GenerateCandidates(candidates);
+		m_mBases.Insert(base, candidates);
+
+		m_aValidationQueue.Insert(candidates);
+		StartProcessing();
+
+		return candidates;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Regenerate and re-validate every base when the candidate generation settings changed (config reload)
+	//------------------------------------------------------------------------------------------------
+	void OnConfigReloaded()
+	{
+		string generationKey = GetGenerationKey();
+		if (generationKey == m_sGenerationKey)
+			return;
+
+		m_sGenerationKey = generationKey;
+		if (m_mBases.IsEmpty())
+			return;
+
+		m_aValidationQueue.Clear();
+		foreach (SCR_CampaignMilitaryBaseComponent base, IPC_BaseSpawnCandidates candidates : m_mBases)
+		{
+			candidates.m_Spawn = new IPC_CandidateSet();
+			candidates.m_Waypoint = new IPC_CandidateSet();
+			candidates.m_Source = new IPC_CandidateSet();
+			GenerateCandidates(candidates);
+			m_aValidationQueue.Insert(candidates);
+		}
+
+		StartProcessing();
+		PrintFormat("[IPC Reinforcement] Spawn ring settings changed - re-validating %1 bases", m_mBases.Count());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Config values that shape the generated candidates and slots
+	//------------------------------------------------------------------------------------------------
+	protected string GetGenerationKey()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		return string.Format("%1|%2|%3|%4|%5|%6|%7", config.m_fSpawnRingInnerRadius, config.m_fReinforcementSpawnRadius,
+			config.m_iSpawnRingCandidates, config.m_iWaypointCandidates, config.m_fSourceBaseSpawnRadius,
+			config.m_iSpawnSlotsPerPosition, config.m_fSpawnSlotSpacing);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get a spawn position on the ring around a base (no world query)
+	//! \return false if the position is an unvalidated candidate (base still validating)
+	//------------------------------------------------------------------------------------------------
+	bool GetSpawnPosition(notnull SCR_CampaignMilitaryBaseComponent base, out vector position)
+	{
+		return PickPosition(base, Prepare(base).m_Spawn, position);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get a waypoint position close to a base (no world query)
+	//! \return false if the position is an unvalidated candidate (base still validating)
+	//------------------------------------------------------------------------------------------------
+	bool GetWaypointPosition(notnull SCR_CampaignMilitaryBaseComponent base, out vector position)
+	{
+		return PickPosition(base, Prepare(base).m_Waypoint, position);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get a spawn position close to a base that sends reinforcements elsewhere (no world query)
+	//! \return false if the position is an unvalidated candidate (base still validating)
+	//------------------------------------------------------------------------------------------------
+	bool GetSourcePosition(notnull SCR_CampaignMilitaryBaseComponent base, out vector position)
+	{
+		return PickPosition(base, Prepare(base).m_Source, position);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the validated formation slots around a spawn or source position picked from this cache
+	//! \return false if the position has no slots (unvalidated candidate or slots still validating)
+	//------------------------------------------------------------------------------------------------
+	bool GetSpawnSlots(notnull SCR_CampaignMilitaryBaseComponent base, vector position, notnull array<vector> slots)
+	{
+		IPC_BaseSpawnCandidates candidates = m_mBases.Get(base);
+		if (!candidates)
+			return false;
+
+		if (FindSlots(candidates.m_Spawn, position, slots))
+			return true;
+
+		return FindSlots(candidates.m_Source, position, slots);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool FindSlots(IPC_CandidateSet set, vector position, notnull array<vector> slots)
+	{
+		foreach (int i, vector anchor : set.m_aValid)
+		{
+			if (vector.DistanceSq(anchor, position) > ANCHOR_TOLERANCE_SQ)
+				continue;
+
+			if (i >= set.m_aSlots.Count() || set.m_aSlots[i].IsEmpty())
+				return false;
+
+			slots.Copy(set.m_aSlots[i]);
+			return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool PickPosition(SCR_CampaignMilitaryBaseComponent base, IPC_CandidateSet set, out vector position)
+	{
+		RandomGenerator random = IPC_ExtendedRandom.GetBaseStream(base);
+
+		if (!set.m_aValid.IsEmpty())
+		{
+			position = IPC_ExtendedRandom.RandomPosition(random, set.m_aValid);
+			return true;
+		}
+
+		if (set.m_aGenerated.IsEmpty())
+			position = base.GetOwner().GetOrigin();
+		else
+			position = IPC_ExtendedRandom.RandomPosition(random, set.m_aGenerated);
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Spiral-sample candidate positions (even coverage of the ring without randomness)
+	//------------------------------------------------------------------------------------------------
+	protected void GenerateCandidates(IPC_BaseSpawnCandidates candidates)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		// Spawn ring: inner radius to inner radius + dispersion (100-300m by default)
+		float innerRadius = config.m_fSpawnRingInnerRadius;
+		float outerRadius = innerRadius + config.m_fReinforcementSpawnRadius;
+		InitSet(candidates.m_Spawn, candidates.m_vBasePos, innerRadius, outerRadius, config.m_iSpawnRingCandidates, UNIT_CLEARANCE);
+		candidates.m_Spawn.m_bHasSlots = true;
+
+		// Waypoint candidates: within 30m of the base
+		InitSet(candidates.m_Waypoint, candidates.m_vBasePos, 0, 30.0, config.m_iWaypointCandidates, WAYPOINT_CLEARANCE);
+
+		// Source candidates: within the source spawn radius (waves sent from this base)
+		InitSet(candidates.m_Source, candidates.m_vBasePos, 0, config.m_fSourceBaseSpawnRadius, config.m_iWaypointCandidates, UNIT_CLEARANCE);
+		candidates.m_Source.m_bHasSlots = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void InitSet(IPC_CandidateSet set, vector center, float minRadius, float maxRadius, int count, float clearance)
+	{
+		set.m_fClearance = clearance;
+		AddSpiral(set.m_aGenerated, center, minRadius, maxRadius, count);
+		set.m_aPending.Copy(set.m_aGenerated);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void AddSpiral(notnull array<vector> output, vector center, float minRadius, float maxRadius, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			float t = (i + 0.5) / count;
+			float radius = Math.Sqrt(Math.Lerp(minRadius * minRadius, maxRadius * maxRadius, t));
+			float angleRad = i * GOLDEN_ANGLE * Math.DEG2RAD;
+
+			vector pos = center;
+			pos[0] = center[0] + Math.Cos(angleRad) * radius;
+			pos[2] = center[2] + Math.Sin(angleRad) * radius;
+			pos[1] = GetGame().GetWorld().GetSurfaceY(pos[0], pos[2]);
+			output.Insert(pos);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void StartProcessing()
+	{
+		if (m_ValidationTask)
+			return;
+
+		m_ValidationTask = new IPC_RingValidationTask();
+		IPC_TaskRunner.GetInstance().Add(m_ValidationTask);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Run one validation step (IPC_RingValidationTask)
+	//! \return true when the queue is empty
+	//------------------------------------------------------------------------------------------------
+	bool ProcessStep()
+	{
+		if (m_aValidationQueue.IsEmpty())
+		{
+			m_ValidationTask = null;
+			return true;
+		}
+
+		IPC_BaseSpawnCandidates candidates = m_aValidationQueue[0];
+
+		// Waypoints first (every wave needs one), then the spawn ring, then source positions
+		if (candidates.m_Waypoint.HasPending())
+			ValidateStep(candidates, candidates.m_Waypoint);
+		else if (candidates.m_Spawn.HasPending())
+			ValidateStep(candidates, candidates.m_Spawn);
+		else if (candidates.m_Source.HasPending())
+			ValidateStep(candidates, candidates.m_Source);
+
+		if (!candidates.HasPending())
+		{
+			PrintFormat("[IPC Reinforcement] Spawn ring cache ready for %1 - %2 spawn / %3 waypoint / %4 source positions (%5 rejected)",
+						candidates.m_sBaseName, candidates.m_Spawn.m_aValid.Count(), candidates.m_Waypoint.m_aValid.Count(),
+						candidates.m_Source.m_aValid.Count(), candidates.m_Spawn.m_iRejected + candidates.m_Waypoint.m_iRejected + candidates.m_Source.m_iRejected);
+			m_aValidationQueue.RemoveOrdered(0);
+		}
+
+		if (!m_aValidationQueue.IsEmpty())
+			return false;
+
+		m_ValidationTask = null;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! One world query: navmesh check of a clear candidate or formation slot, else sphere query of a
+	//! pending candidate, else sphere query of a pending formation slot
+	//------------------------------------------------------------------------------------------------
+	protected void ValidateStep(IPC_BaseSpawnCandidates candidates, IPC_CandidateSet set)
+	{
+		if (!set.m_aClear.IsEmpty())
+		{
+			vector clearPos = set.m_aClear[set.m_aClear.Count() - 1];
+			set.m_aClear.Remove(set.m_aClear.Count() - 1);
+
+			vector snappedPos;
+			if (IPC_NavmeshTools.IsReachable(candidates.m_vBasePos, clearPos, snappedPos))
+			{
+				set.m_aValid.Insert(snappedPos);
+				if (set.m_bHasSlots)
+					QueueSlots(set, set.m_aValid.Count() - 1);
+			}
+			else
+			{
+				set.m_iRejected++;
+			}
+
+			return;
+		}
+
+		// Slots must be reachable from their anchor - a slot behind a wall would strand its unit
+		if (!set.m_aSlotClear.IsEmpty())
+		{
+			vector clearSlot = set.m_aSlotClear[set.m_aSlotClear.Count() - 1];
+			int clearAnchorIndex = set.m_aSlotClearAnchor[set.m_aSlotClearAnchor.Count() - 1];
+			set.m_aSlotClear.Remove(set.m_aSlotClear.Count() - 1);
+			set.m_aSlotClearAnchor.Remove(set.m_aSlotClearAnchor.Count() - 1);
+
+			vector snappedSlot;
+			if (IPC_NavmeshTools.IsReachable(set.m_aValid[clearAnchorIndex], clearSlot, snappedSlot))
+				set.m_aSlots[clearAnchorIndex].Insert(snappedSlot);
+
+			return;
+		}
+
+		if (set.m_aPending.IsEmpty())
+		{
+			vector slot = set.m_aSlotPending[set.m_aSlotPending.Count() - 1];
+			int anchorIndex = set.m_aSlotPendingAnchor[set.m_aSlotPendingAnchor.Count() - 1];
+			set.m_aSlotPending.Remove(set.m_aSlotPending.Count() - 1);
+			set.m_aSlotPendingAnchor.Remove(set.m_aSlotPendingAnchor.Count() - 1);
+
+			if (IsClear(slot, SLOT_CLEARANCE))
+			{
+				set.m_aSlotClear.Insert(slot);
+				set.m_aSlotClearAnchor.Insert(anchorIndex);
+			}
+
+			return;
+		}
+
+		vector candidate = set.m_aPending[set.m_aPending.Count() - 1];
+		set.m_aPending.Remove(set.m_aPending.Count() - 1);
+
+		if (IsClear(candidate, set.m_fClearance))
+			set.m_aClear.Insert(candidate);
+		else
+			set.m_iRejected++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Generate the formation slot candidates of a valid position (sunflower disc, about one
+	//! m_fSpawnSlotSpacing between neighbours)
+	//------------------------------------------------------------------------------------------------
+	protected void QueueSlots(IPC_CandidateSet set, int anchorIndex)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		int count = config.m_iSpawnSlotsPerPosition;
+		float radius = config.m_fSpawnSlotSpacing * Math.Sqrt(count / Math.PI);
+
+		set.m_aSlots.Insert(new array<vector>());
+
+		array<vector> slots = {};
+		AddSpiral(slots, set.m_aValid[anchorIndex], 0, radius, count);
+		foreach (vector slot : slots)
+		{
+			set.m_aSlotPending.Insert(slot);
+			set.m_aSlotPendingAnchor.Insert(anchorIndex);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Sphere query just above the ground for anything with collision
+	//------------------------------------------------------------------------------------------------
+	protected bool IsClear(vector position, float radius)
+	{
+		m_bClearanceBlocked = false;
+
+		vector center = position;
+		center[1] = center[1] + radius + 0.5;
+
+		GetGame().GetWorld().QueryEntitiesBySphere(center, radius, OnClearanceEntity, FilterClearanceEntity,
+												   EQueryEntitiesFlags.STATIC | EQueryEntitiesFlags.DYNAMIC);
+		return !m_bClearanceBlocked;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Only entities with collision block a position (terrain is skipped by lifting the sphere)
+	//------------------------------------------------------------------------------------------------
+	protected bool FilterClearanceEntity(IEntity entity)
+	{
+		return entity.GetPhysics() != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool OnClearanceEntity(IEntity entity)
+	{
+		m_bClearanceBlocked = true;
+		return false;	// First blocker is enough - stop the query
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of candidates still waiting for validation (all bases)
+	//------------------------------------------------------------------------------------------------
+	int GetPendingCount()
+	{
+		int pending;
+		foreach (IPC_BaseSpawnCandidates candidates : m_aValidationQueue)
+		{
+			pending += candidates.m_Spawn.GetPendingCount() + candidates.m_Waypoint.GetPendingCount() + candidates.m_Source.GetPendingCount();
+		}
+
+		return pending;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append cache state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		int validSpawn, validWaypoint, validSource, rejected, slots;
+		foreach (SCR_CampaignMilitaryBaseComponent base, IPC_BaseSpawnCandidates candidates : m_mBases)
+		{
+			validSpawn += candidates.m_Spawn.m_aValid.Count();
+			validWaypoint += candidates.m_Waypoint.m_aValid.Count();
+			validSource += candidates.m_Source.m_aValid.Count();
+			rejected += candidates.m_Spawn.m_iRejected + candidates.m_Waypoint.m_iRejected + candidates.m_Source.m_iRejected;
+			slots += candidates.m_Spawn.GetSlotCount() + candidates.m_Source.GetSlotCount();
+		}
+
+		lines.Insert(string.Format("Spawn ring cache: %1 bases | %2 spawn / %3 waypoint / %4 source positions | %5 formation slots | %6 rejected | %7 candidates pending",
+			m_mBases.Count(), validSpawn, validWaypoint, validSource, slots, rejected, GetPendingCount()));
+		lines.Insert(string.Format("Route cache: %1 routes | %2 pending", IPC_RouteCache.GetInstance().GetCount(), IPC_RouteCache.GetInstance().GetPendingCount()));
+	}
+}
@@ -0,0 +1,278 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Task Runner
+// Cooperative scheduler for script work that is spread over several frames
+//
+// A task is a resumable state machine: Step() does one small unit of work and returns true when
+// the task is finished. Every frame the runner steps tasks in priority order until the frame
+// budget (m_iTaskFrameBudgetMs) is spent - at least one step always runs so nothing starves.
+// A task that calls Sleep() leaves the frame loop and is re-queued by a one-shot CallLater when it
+// wakes, so the runner only runs per frame while some task is awake. Tasks are cancelled with
+// Cancel() or automatically when their owner is deleted, and report per-task-name cost statistics
+// ("#ipcext stats", time summed per task name and averaged per step - see IPC_ScriptTimer).
+//------------------------------------------------------------------------------------------------
+
+enum IPC_ETaskPriority
+{
+	HIGH,
+	NORMAL,
+	LOW
+}
+
+class IPC_Task
+{
+	protected IPC_ETaskPriority m_ePriority = IPC_ETaskPriority.NORMAL;
+	protected int m_iMaxStepsPerFrame = 1;
+	protected int m_iState;							// State machine position, owned by the derived task
+	protected float m_fWakeTime;					// World time (ms) the task may run again
+	protected bool m_bCancelled;
+
+	protected Managed m_Owner;						// Weak - task is cancelled once the owner is deleted
+	protected bool m_bHasOwner;
+
+	//------------------------------------------------------------------------------------------------
+	//! Do one unit of work
+	//! \return true when the task is finished
+	//------------------------------------------------------------------------------------------------
+	bool Step()
+	{
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Name used for cost statistics
+	//------------------------------------------------------------------------------------------------
+	string GetName()
+	{
+		return ClassName();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Do not step this task again for a while
+	//------------------------------------------------------------------------------------------------
+	void Sleep(int ms)
+	{
+		m_fWakeTime = GetGame().GetWorld().GetWorldTime() + ms;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Tie the task to an owner - it is cancelled once the owner is deleted
+	//------------------------------------------------------------------------------------------------
+	void SetOwner(Managed owner)
+	{
+		m_Owner = owner;
+		m_bHasOwner = owner != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Cancel()
+	{
+		m_bCancelled = true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsCancelled()
+	{
+		return m_bCancelled || (m_bHasOwner && !m_Owner);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool IsAwake(float now)
+	{
+		return m_fWakeTime <= now;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Time left until the task wakes (ms, 0 when awake)
+	//------------------------------------------------------------------------------------------------
+	int GetSleepTime(float now)
+	{
+		return Math.Max(m_fWakeTime - now, 0);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	IPC_ETaskPriority GetPriority()
+	{
+		return m_ePriority;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int GetMaxStepsPerFrame()
+	{
+		return m_iMaxStepsPerFrame;
+	}
+}
+
+class IPC_TaskStats
+{
+	int m_iSteps;
+	int m_iTimeMs;
+	int m_iCompleted;
+	int m_iCancelled;
+}
+
+class IPC_TaskRunner
+{
+	protected static ref IPC_TaskRunner s_Instance;
+
+	protected ref array<ref IPC_Task> m_aTasks = {};		// Awake tasks, sorted by priority, FIFO within a priority
+	protected ref array<ref IPC_Task> m_aSleeping = {};		// Waiting for their wake-up call (Wake)
+	protected ref map<string, ref IPC_TaskStats> m_mStats = new map<string, ref IPC_TaskStats>();
+	protected bool m_bRunning;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_TaskRunner GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_TaskRunner();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Queue a task (first step runs next frame at the earliest)
+	//------------------------------------------------------------------------------------------------
+	IPC_Task Add(notnull IPC_Task task)
+	{
+		int index = m_aTasks.Count();
+		foreach (int i, IPC_Task queued : m_aTasks)
+		{
+			if (task.GetPriority() < queued.GetPriority())
+			{
+				index = i;
+				break;
+			}
+		}
+
+		m_aTasks.InsertAt(task, index);
+
+		if (!m_bRunning)
+		{
+			m_bRunning = true;
+			GetGame().GetCallqueue().CallLater(Run, 0, true);
+		}
+
+		return task;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of queued tasks (awake and sleeping)
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_aTasks.Count() + m_aSleeping.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Take a task that went to sleep out of the frame loop until its wake time
+	//------------------------------------------------------------------------------------------------
+	protected void Park(IPC_Task task, float now)
+	{
+		m_aSleeping.Insert(task);
+		GetGame().GetCallqueue().CallLater(Wake, task.GetSleepTime(now), false, task);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Wake-up call of a sleeping task - back into the frame loop
+	//------------------------------------------------------------------------------------------------
+	protected void Wake(IPC_Task task)
+	{
+		Add(task);
+		m_aSleeping.RemoveItem(task);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Step tasks in priority order within the frame budget
+	//------------------------------------------------------------------------------------------------
+	protected void Run()
+	{
+		int frameStart = IPC_ScriptTimer.Start();
+		int budget = IPC_ExtendedConfig.GetInstance().m_iTaskFrameBudgetMs;
+		float now = GetGame().GetWorld().GetWorldTime();
+		bool stepped;
+
+		for (int i = 0; i < m_aTasks.Count(); i++)
+		{
+			IPC_Task task = m_aTasks[i];
+			IPC_TaskStats stats = GetTaskStats(task.GetName());
+
+			if (task.IsCancelled())
+			{
+				stats.m_iCancelled++;
+				m_aTasks.RemoveOrdered(i);
+				i--;
+				continue;
+			}
+
+			// Budget spent - remaining tasks continue next frame
+			if (stepped && IPC_ScriptTimer.Elapsed(frameStart) >= budget)
+				break;
+
+			bool finished;
+			for (int steps = task.GetMaxStepsPerFrame(); steps > 0 && !finished && task.IsAwake(now); steps--)
+			{
+				int stepStart = IPC_ScriptTimer.Start();
+				finished = task.Step();
+				stats.m_iSteps++;
+				stats.m_iTimeMs += IPC_ScriptTimer.Elapsed(stepStart);
+				stepped = true;
+
+				if (IPC_ScriptTimer.Elapsed(frameStart) >= budget)
+					break;
+			}
+
+			if (finished)
+			{
+				stats.m_iCompleted++;
+				m_aTasks.RemoveOrdered(i);
+				i--;
+			}
+			else if (!task.IsAwake(now))
+			{
+				Park(task, now);
+				m_aTasks.RemoveOrdered(i);
+				i--;
+			}
+		}
+
+		if (m_aTasks.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Run);
+			m_bRunning = false;
+		}
+
+		IPC_ScriptTimer.Stop(frameStart);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected IPC_TaskStats GetTaskStats(string name)
+	{
+		IPC_TaskStats stats = m_mStats.Get(name);
+		if (!stats)
+		{
+			stats = new IPC_TaskStats();
+			m_mStats.Insert(name, stats);
+		}
+
+		return stats;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append task costs to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Task runner: %1 queued, %2 sleeping (frame budget %3 ms)",
+			m_aTasks.Count(), m_aSleeping.Count(), IPC_ExtendedConfig.GetInstance().m_iTaskFrameBudgetMs));
+
+		foreach (string name, IPC_TaskStats stats : m_mStats)
+		{
+			// Per-step values are below the clock resolution - only the average over all steps is meaningful
+			float usPerStep;
+			if (stats.m_iSteps > 0)
+				usPerStep = stats.m_iTimeMs * 1000.0 / stats.m_iSteps;
+
+			lines.Insert(string.Format("  %1: %2 steps, %3 ms (avg %4 us/step) | %5 completed, %6 cancelled",
+				name, stats.m_iSteps, stats.m_iTimeMs, Math.Round(usPerStep), stats.m_iCompleted, stats.m_iCancelled));
+		}
+	}
+}
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Input Trace Recorder
+// Logs every input the combat logic consumes so a session can be replayed offline
+//
+// Start/stop with the admin command "#ipcext record start|stop [name]".
+// File: $profile:IPC_ExtendedTrace_<name>.txt - one record per line, space separated:
+//   H <version> <seed>                                  header
+//   B <baseIdx> <faction|-> <x> <z> <name>              base table entry (first seen / owner changed)
+//   E <faction> <hostile,hostile|->                     hostile factions (first seen)
+//   C <timeMs> <spawnIdx> <baseIdx> <faction> <count>   coordinator check, followed by <count> P lines
+//   U <timeMs> <spawnIdx> <baseIdx> <faction> <count>   target update (frontline + cleanup), followed by P lines
+//   P <playerId> <faction|-> <alive 0|1> <x> <y> <z>    player sample
+//------------------------------------------------------------------------------------------------
+
+class IPC_TraceRecorder
+{
+	static const int TRACE_VERSION = 1;
+	static const string EMPTY_TOKEN = "-";
+
+	protected static ref FileHandle s_File;
+	protected static string s_sFileName;
+	protected static int s_iRecords;
+
+	protected static ref map<int, string> s_mBaseFactions = new map<int, string>();					// Last written owner per base index
+	protected static ref map<IPC_DefenderSpawnPointComponent, int> s_mSpawnIndices = new map<IPC_DefenderSpawnPointComponent, int>();
+	protected static ref array<string> s_aHostilesWritten = {};
+
+	//------------------------------------------------------------------------------------------------
+	//! Get trace file path for a recording name
+	//------------------------------------------------------------------------------------------------
+	static string GetTracePath(string name)
+	{
+		if (name.IsEmpty())
+			name = "default";
+
+		return string.Format("$profile:IPC_ExtendedTrace_%1.txt", name);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start recording (stops a running recording first)
+	//------------------------------------------------------------------------------------------------
+	static bool Start(string name)
+	{
+		Stop();
+
+		s_sFileName = GetTracePath(name);
+		s_File = FileIO.OpenFile(s_sFileName, FileMode.WRITE);
+		if (!s_File)
+		{
+			Print(string.Format("[IPC Extended] ERROR: Cannot open trace file %1", s_sFileName), LogLevel.ERROR);
+			return false;
+		}
+
+		s_iRecords = 0;
+		s_mBaseFactions.Clear();
+		s_mSpawnIndices.Clear();
+		s_aHostilesWritten.Clear();
+
+		s_File.WriteLine(string.Format("H %1 %2", TRACE_VERSION, IPC_ExtendedRandom.GetSessionSeed()));
+		PrintFormat("[IPC Extended] Trace recording started: %1", s_sFileName);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stop recording and close the file
+	//------------------------------------------------------------------------------------------------
+	static void Stop()
+	{
+		if (!s_File)
+			return;
+
+		s_File.Close();
+		s_File = null;
+		PrintFormat("[IPC Extended] Trace recording stopped: %1 (%2 records)", s_sFileName, s_iRecords);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static bool IsRecording()
+	{
+		return s_File != null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record the inputs of a coordinator reinforcement check
+	//------------------------------------------------------------------------------------------------
+	static void RecordCheck(IPC_CombatSnapshot snapshot, IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		if (s_File)
+			WriteEvaluation("C", snapshot, spawnPoint);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record the inputs of a defender target update (frontline detection and rear-base cleanup)
+	//------------------------------------------------------------------------------------------------
+	static void RecordTargetUpdate(IPC_CombatSnapshot snapshot, IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		if (s_File)
+			WriteEvaluation("U", snapshot, spawnPoint);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Write base table changes, hostile factions and the evaluation record with its players
+	//------------------------------------------------------------------------------------------------
+	protected static void WriteEvaluation(string recordType, IPC_CombatSnapshot snapshot, IPC_DefenderSpawnPointComponent spawnPoint)
+	{
+		SCR_CampaignMilitaryBaseComponent nearBase = spawnPoint.GetNearBase();
+		int baseIndex = -1;
+
+		foreach (IPC_BaseSample base : snapshot.m_aBases)
+		{
+			if (base.m_Base == nearBase)
+				baseIndex = base.m_iIndex;
+
+			string lastFaction;
+			if (s_mBaseFactions.Find(base.m_iIndex, lastFaction) && lastFaction == base.m_sFactionKey)
+				continue;
+
+			s_mBaseFactions.Set(base.m_iIndex, base.m_sFactionKey);
+			s_File.WriteLine(string.Format("B %1 %2 %3 %4 %5", base.m_iIndex, Token(base.m_sFactionKey),
+										   base.m_vPosition[0], base.m_vPosition[2], Token(base.m_sName)));
+		}
+
+		string factionKey;
+		Faction faction = spawnPoint.GetDefenderFaction();
+		if (faction)
+			factionKey = faction.GetFactionKey();
+
+		if (!factionKey.IsEmpty() && !s_aHostilesWritten.Contains(factionKey))
+		{
+			s_aHostilesWritten.Insert(factionKey);
+
+			array<string> hostileFactionKeys = {};
+			spawnPoint.GetHostileFactionKeys(hostileFactionKeys);
+
+			string hostiles;
+			foreach (int i, string hostileKey : hostileFactionKeys)
+			{
+				if (i > 0)
+					hostiles += ",";
+				hostiles += hostileKey;
+			}
+
+			s_File.WriteLine(string.Format("E %1 %2", factionKey, Token(hostiles)));
+		}
+
+		int spawnIndex;
+		if (!s_mSpawnIndices.Find(spawnPoint, spawnIndex))
+		{
+			spawnIndex = s_mSpawnIndices.Count();
+			s_mSpawnIndices.Insert(spawnPoint, spawnIndex);
+		}
+
+		s_File.WriteLine(string.Format("%1 %2 %3 %4 %5 %6", recordType, Math.Round(snapshot.m_fTime), spawnIndex,
+									   baseIndex, Token(factionKey), snapshot.m_aPlayers.Count()));
+
+		foreach (IPC_PlayerSample player : snapshot.m_aPlayers)
+		{
+			int alive = 0;
+			if (player.m_bAlive)
+				alive = 1;
+
+			s_File.WriteLine(string.Format("P %1 %2 %3 %4 %5 %6", player.m_iPlayerId, Token(player.m_sFactionKey), alive,
+										   player.m_vPosition[0], player.m_vPosition[1], player.m_vPosition[2]));
+		}
+
+		s_iRecords++;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Make a value safe for the space separated format
+	//------------------------------------------------------------------------------------------------
+	protected static string Token(string value)
+	{
+		if (value.IsEmpty())
+			return EMPTY_TOKEN;
+
+		value.Replace(" ", "_");
+		return value;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Read a token written by Token()
+	//------------------------------------------------------------------------------------------------
+	static string FromToken(string token)
+	{
+		if (token == EMPTY_TOKEN)
+			return string.Empty;
+
+		return token;
+	}
+}
@@ -0,0 +1,301 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Trace Replay
+// Feeds a recorded input trace through the wave, frontline and cleanup logic without spawning
+//
+// Run with the admin command "#ipcext replay [name]". Every recorded evaluation is rebuilt as an
+// IPC_CombatSnapshot and driven through IPC_BaseDecisionState with the current configuration,
+// so threshold changes can be compared on real session data. Decisions are written to the log;
+// the summary includes the decision-logic cost per evaluation, averaged over the whole trace
+// (single evaluations are far below the millisecond clock - see IPC_ScriptTimer).
+// The trace is read on the task runner (RECORDS_PER_STEP records per step, low priority), so a
+// long trace can be replayed on a live server without a frame spike; one replay runs at a time.
+// Not simulated: reinforcement pool deferral and the director budget (every due wave is assumed to fire).
+//------------------------------------------------------------------------------------------------
+
+class IPC_TraceReplayTask : IPC_Task
+{
+	protected ref IPC_TraceReplay m_Replay;
+
+	//------------------------------------------------------------------------------------------------
+	void IPC_TraceReplayTask(notnull IPC_TraceReplay replay)
+	{
+		m_Replay = replay;
+		m_ePriority = IPC_ETaskPriority.LOW;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	override bool Step()
+	{
+		return m_Replay.ProcessRecords();
+	}
+}
+
+class IPC_TraceReplay
+{
+	protected static const int RECORDS_PER_STEP = 50;
+
+	protected static IPC_TraceReplay s_Running;			// Replay currently on the task runner
+
+	protected ref FileHandle m_File;
+	protected string m_sPath;
+
+	protected ref map<int, ref IPC_BaseDecisionState> m_mStates = new map<int, ref IPC_BaseDecisionState>();	// Per spawn index
+	protected ref map<int, bool> m_mKeepActive = new map<int, bool>();						// Last target decision per spawn index
+	protected ref map<int, ref IPC_BaseSample> m_mBases = new map<int, ref IPC_BaseSample>();
+	protected ref array<ref IPC_BaseSample> m_aBaseTable = {};
+	protected ref map<string, ref array<string>> m_mHostiles = new map<string, ref array<string>>();
+	protected ref IPC_FrontlineMap m_Frontline = new IPC_FrontlineMap();
+
+	// Results
+	protected int m_iChecks;
+	protected int m_iTargetUpdates;
+	protected int m_iCombatStarts;
+	protected int m_iCombatEnds;
+	protected int m_iWaves;
+	protected int m_iDespawns;
+	protected int m_iLogicMs;			// Time spent in decision logic (excludes parsing), summed over all evaluations
+
+	//------------------------------------------------------------------------------------------------
+	//! Start replaying a recorded trace on the task runner (summary is written to the log when done)
+	//------------------------------------------------------------------------------------------------
+	static string Run(string name)
+	{
+		if (s_Running)
+			return string.Format("Replay of %1 still running - try again when its summary is logged", s_Running.m_sPath);
+
+		string path = IPC_TraceRecorder.GetTracePath(name);
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return string.Format("Cannot open trace %1", path);
+
+		IPC_TraceReplay replay = new IPC_TraceReplay();
+		replay.m_File = file;
+		replay.m_sPath = path;
+		s_Running = replay;
+
+		IPC_TaskRunner.GetInstance().Add(new IPC_TraceReplayTask(replay));
+
+		PrintFormat("[IPC Replay] Replaying %1", path);
+		return string.Format("Replaying %1 - summary follows in the server log", path);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Replay the next records of the trace (IPC_TraceReplayTask)
+	//! \return true when the trace is finished
+	//------------------------------------------------------------------------------------------------
+	bool ProcessRecords()
+	{
+		string line;
+		array<string> tokens = {};
+
+		for (int records = 0; records < RECORDS_PER_STEP; records++)
+		{
+			if (m_File.ReadLine(line) < 0)
+			{
+				Finish();
+				return true;
+			}
+
+			tokens.Clear();
+			line.Split(" ", tokens, true);
+			if (tokens.IsEmpty())
+				continue;
+
+			string recordType = tokens[0];
+			if (recordType == "B")
+				ReadBase(tokens);
+			else if (recordType == "E")
+				ReadHostiles(tokens);
+			else if (recordType == "C" || recordType == "U")
+				ReadEvaluation(m_File, tokens);
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Close the trace and log the summary
+	//------------------------------------------------------------------------------------------------
+	protected void Finish()
+	{
+		m_File.Close();
+		s_Running = null;
+
+		int evaluations = m_iChecks + m_iTargetUpdates;
+		float avgUs;
+		if (evaluations > 0)
+			avgUs = m_iLogicMs * 1000.0 / evaluations;
+
+		string summary = string.Format("Replay %1: %2 checks, %3 target updates | combat starts: %4, ends: %5 | waves: %6 | despawns: %7 | logic: %8 ms total, %9 us/evaluation (average)",
+									   m_sPath, m_iChecks, m_iTargetUpdates, m_iCombatStarts, m_iCombatEnds, m_iWaves, m_iDespawns, m_iLogicMs, avgUs.ToString(-1, 1));
+		PrintFormat("[IPC Replay] %1", summary);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! B <baseIdx> <faction|-> <x> <z> <name>
+	//------------------------------------------------------------------------------------------------
+	protected void ReadBase(array<string> tokens)
+	{
+		if (tokens.Count() < 6)
+			return;
+
+		int index = tokens[1].ToInt();
+		IPC_BaseSample base = m_mBases.Get(index);
+		if (!base)
+		{
+			base = new IPC_BaseSample();
+			base.m_iIndex = index;
+			m_mBases.Insert(index, base);
+			m_aBaseTable.Insert(base);
+		}
+
+		base.m_sFactionKey = IPC_TraceRecorder.FromToken(tokens[2]);
+		base.m_vPosition = Vector(tokens[3].ToFloat(), 0, tokens[4].ToFloat());
+		base.m_sName = IPC_TraceRecorder.FromToken(tokens[5]);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! E <faction> <hostile,hostile|->
+	//------------------------------------------------------------------------------------------------
+	protected void ReadHostiles(array<string> tokens)
+	{
+		if (tokens.Count() < 3)
+			return;
+
+		array<string> hostiles = {};
+		string hostileList = IPC_TraceRecorder.FromToken(tokens[2]);
+		if (!hostileList.IsEmpty())
+			hostileList.Split(",", hostiles, true);
+
+		m_mHostiles.Set(tokens[1], hostiles);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! C|U <timeMs> <spawnIdx> <baseIdx> <faction> <count> followed by <count> P lines
+	//------------------------------------------------------------------------------------------------
+	protected void ReadEvaluation(FileHandle file, array<string> header)
+	{
+		if (header.Count() < 6)
+			return;
+
+		IPC_CombatSnapshot snapshot = new IPC_CombatSnapshot();
+		snapshot.m_fTime = header[1].ToFloat();
+		snapshot.m_aBases = m_aBaseTable;
+
+		int spawnIndex = header[2].ToInt();
+		IPC_BaseSample base = m_mBases.Get(header[3].ToInt());
+		string factionKey = IPC_TraceRecorder.FromToken(header[4]);
+		int playerCount = header[5].ToInt();
+
+		string line;
+		array<string> tokens = {};
+		for (int i = 0; i < playerCount; i++)
+		{
+			if (file.ReadLine(line) < 0)
+				break;
+
+			tokens.Clear();
+			line.Split(" ", tokens, true);
+			if (tokens.Count() < 7 || tokens[0] != "P")
+				continue;
+
+			IPC_PlayerSample player = new IPC_PlayerSample();
+			player.m_iPlayerId = tokens[1].ToInt();
+			player.m_sFactionKey = IPC_TraceRecorder.FromToken(tokens[2]);
+			player.m_bAlive = tokens[3].ToInt() != 0;
+			player.m_vPosition = Vector(tokens[4].ToFloat(), tokens[5].ToFloat(), tokens[6].ToFloat());
+			snapshot.m_aPlayers.Insert(player);
+		}
+
+		if (!base)
+			return;
+
+		IPC_BaseDecisionState state = m_mStates.Get(spawnIndex);
+		if (!state)
+		{
+			state = new IPC_BaseDecisionState();
+			m_mStates.Insert(spawnIndex, state);
+		}
+
+		int startTick = IPC_ScriptTimer.Start();
+
+		if (header[0] == "C")
+			ReplayCheck(snapshot, state, base, factionKey);
+		else
+			ReplayTargetUpdate(snapshot, state, spawnIndex, base, factionKey);
+
+		m_iLogicMs += IPC_ScriptTimer.Elapsed(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Same flow as IPC_DefenderSpawnPointComponent.EvaluateReinforcements() without spawning
+	//------------------------------------------------------------------------------------------------
+	protected void ReplayCheck(IPC_CombatSnapshot snapshot, IPC_BaseDecisionState state, IPC_BaseSample base, string factionKey)
+	{
+		m_iChecks++;
+
+		bool combatActive = !factionKey.IsEmpty() && base.m_sFactionKey == factionKey
+							&& IPC_BaseDecisionState.IsUnderAttack(snapshot, base.m_iIndex);
+
+		bool started;
+		bool ended;
+		int dueWave = state.UpdateCombat(combatActive, snapshot.m_fTime, started, ended);
+
+		if (started)
+		{
+			m_iCombatStarts++;
+			PrintFormat("[IPC Replay] t=%1s Combat detected at %2", snapshot.m_fTime / 1000.0, base.m_sName);
+		}
+
+		if (ended)
+		{
+			m_iCombatEnds++;
+			PrintFormat("[IPC Replay] t=%1s Combat ended at %2 - reset", snapshot.m_fTime / 1000.0, base.m_sName);
+			return;
+		}
+
+		if (dueWave > 0)
+		{
+			state.OnWaveTriggered(dueWave, snapshot.m_fTime);
+			m_iWaves++;
+			PrintFormat("[IPC Replay] t=%1s WAVE %2 would trigger at %3 (combat duration: %4s)",
+						snapshot.m_fTime / 1000.0, dueWave, base.m_sName, state.GetCombatDuration(snapshot.m_fTime));
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Same flow as IPC_DefenderSpawnPointComponent.UpdateTarget() without despawning
+	//------------------------------------------------------------------------------------------------
+	protected void ReplayTargetUpdate(IPC_CombatSnapshot snapshot, IPC_BaseDecisionState state, int spawnIndex, IPC_BaseSample base, string factionKey)
+	{
+		m_iTargetUpdates++;
+
+		// Enemy bases keep the parent mod's default behavior
+		bool keepActive = true;
+		if (snapshot.HasPlayerOfFaction(base.m_sFactionKey))
+		{
+			array<string> hostiles = m_mHostiles.Get(factionKey);
+			if (!hostiles)
+				hostiles = {};
+
+			bool graceStarted;
+			bool onFrontline = IPC_BaseDecisionState.IsOnFrontline(m_Frontline, snapshot, base.m_iIndex, hostiles);
+			keepActive = state.UpdateGracePeriod(onFrontline, snapshot.m_fTime, graceStarted);
+
+			if (graceStarted)
+				PrintFormat("[IPC Replay] t=%1s Base %2 became inactive - grace period started", snapshot.m_fTime / 1000.0, base.m_sName);
+		}
+
+		bool wasActive = true;
+		if (m_mKeepActive.Contains(spawnIndex))
+			wasActive = m_mKeepActive.Get(spawnIndex);
+
+		m_mKeepActive.Set(spawnIndex, keepActive);
+
+		if (wasActive && !keepActive)
+		{
+			m_iDespawns++;
+			PrintFormat("[IPC Replay] t=%1s Base %2 defenders would despawn (spawn point %3)", snapshot.m_fTime / 1000.0, base.m_sName, spawnIndex);
+		}
+	}
+}
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Virtual Helicopter Approach
+// Simulates the wave 4 helicopter ingress as a moving point instead of a flying airframe
+//
+// The approach starts at the usual spawn position (m_fHelicopterSpawnDistance out) and moves
+// along the straight ingress path to the base at m_fHelicopterApproachSpeed on a 1 s timer,
+// m_fHelicopterSpawnAltitude above the terrain under its current position.
+// The real Mi-8 and crew are only spawned when the point is within
+// m_fHelicopterMaterializeDistance of the base, or when a player comes within
+// m_fHelicopterVisualRange of it. The crew's AI budget share is checked again at that point; if it
+// filled up during the approach the helicopter is dropped and its pool cost refunded. An approach
+// whose coordinator is gone (base despawned) is dropped and refunded the same way, so each approach
+// carries its own faction and cost. Nothing is simulated while no approach is in flight.
+//------------------------------------------------------------------------------------------------
+
+class IPC_VirtualApproach
+{
+	IPC_DefenderSpawnPointComponent m_SpawnPoint;	// Coordinator that materializes the helicopter
+	vector m_vStart;
+	vector m_vTarget;
+	float m_fStartTime;								// World time (ms)
+	vector m_vPosition;								// Current virtual position (altitude included)
+	Faction m_Faction;								// Pool the wave was paid from
+	int m_iCost;									// Pool cost refunded if the helicopter is dropped
+}
+
+class IPC_VirtualHelicopter
+{
+	protected static const int TICK_INTERVAL = 1000;	// ms
+
+	protected static ref IPC_VirtualHelicopter s_Instance;
+
+	protected ref array<ref IPC_VirtualApproach> m_aApproaches = {};
+	protected bool m_bTicking;
+	protected int m_iMaterialized;
+	protected int m_iDropped;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_VirtualHelicopter GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_VirtualHelicopter();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start a virtual approach from start to the target base position, paid with cost from faction's pool
+	//------------------------------------------------------------------------------------------------
+	void Start(notnull IPC_DefenderSpawnPointComponent spawnPoint, vector start, vector target, Faction faction, int cost)
+	{
+		IPC_VirtualApproach approach = new IPC_VirtualApproach();
+		approach.m_SpawnPoint = spawnPoint;
+		approach.m_Faction = faction;
+		approach.m_iCost = cost;
+		approach.m_vStart = start;
+		approach.m_vTarget = target;
+		approach.m_vPosition = start;
+		approach.m_fStartTime = GetGame().GetWorld().GetWorldTime();
+		m_aApproaches.Insert(approach);
+
+		PrintFormat("[IPC Reinforcement] Virtual helicopter approach started %1m out (%2 in flight)",
+					vector.DistanceXZ(start, target), m_aApproaches.Count());
+
+		if (!m_bTicking)
+		{
+			m_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, TICK_INTERVAL, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Advance every approach and materialize the ones that arrived or were spotted
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		BaseWorld world = GetGame().GetWorld();
+		float now = world.GetWorldTime();
+		IPC_CombatSnapshot snapshot = IPC_CombatSnapshot.Capture(false);
+
+		for (int i = m_aApproaches.Count() - 1; i >= 0; i--)
+		{
+			IPC_VirtualApproach approach = m_aApproaches[i];
+
+			// Coordinator gone (base despawned) - approach is dropped and its pool cost refunded
+			if (!approach.m_SpawnPoint)
+			{
+				m_aApproaches.Remove(i);
+				m_iDropped++;
+				IPC_ReinforcementPool.GetInstance().Refund(approach.m_Faction, approach.m_iCost);
+				PrintFormat("[IPC Reinforcement] Virtual helicopter dropped - coordinator gone, %1 refunded", approach.m_iCost);
+				continue;
+			}
+
+			float totalDistance = vector.DistanceXZ(approach.m_vStart, approach.m_vTarget);
+			float travelled = config.m_fHelicopterApproachSpeed * (now - approach.m_fStartTime) / 1000.0;
+			float progress = 1;
+			if (totalDistance > 0)
+				progress = Math.Min(travelled / totalDistance, 1);
+
+			// Interpolate on the ground plane, cruise altitude above the terrain below (valleys and ridges on the way)
+			approach.m_vPosition = vector.Lerp(approach.m_vStart, approach.m_vTarget, progress);
+			approach.m_vPosition[1] = world.GetSurfaceY(approach.m_vPosition[0], approach.m_vPosition[2]) + config.m_fHelicopterSpawnAltitude;
+
+			bool arrived = totalDistance - travelled <= config.m_fHelicopterMaterializeDistance;
+			bool spotted = IsPlayerInRange(snapshot, approach.m_vPosition, config.m_fHelicopterVisualRange);
+			if (!arrived && !spotted)
+				continue;
+
+			if (spotted && !arrived)
+				PrintFormat("[IPC Reinforcement] Virtual helicopter spotted by a player - materializing %1m from base",
+							Math.Floor(totalDistance - travelled));
+
+			m_aApproaches.Remove(i);
+			m_iMaterialized++;
+			approach.m_SpawnPoint.MaterializeHelicopter(approach.m_vPosition, approach.m_Faction, approach.m_iCost);
+		}
+
+		if (m_aApproaches.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			m_bTicking = false;
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected bool IsPlayerInRange(IPC_CombatSnapshot snapshot, vector position, float range)
+	{
+		float rangeSq = range * range;
+		foreach (IPC_PlayerSample player : snapshot.m_aPlayers)
+		{
+			if (player.m_bAlive && vector.DistanceSq(player.m_vPosition, position) < rangeSq)
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Number of approaches currently simulated (their crews are not in the AI budget yet)
+	//------------------------------------------------------------------------------------------------
+	int GetCount()
+	{
+		return m_aApproaches.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append approach state to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Virtual helicopters: %1 in flight | %2 materialized | %3 dropped", m_aApproaches.Count(), m_iMaterialized, m_iDropped));
+	}
+}
@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Wave Metrics
+// Outcome of every reinforcement group, aggregated per base and group type
+//
+// Each group is sampled every 5 s while alive:
+//   contact - first sample with an alive hostile player within m_fMetricsContactRange
+//   idle    - time alive with no hostile player within m_fMetricsIdleRange (500 m)
+//   kills   - players killed by a member of the group (Modded_SCR_BaseGameMode)
+//   losses  - peak agent count minus agents alive when the record closes
+// Waves 1-3 are tracked per group, wave 4 as the helicopter crew group (HELICOPTER_CREW).
+// A record closes when the group is wiped out, despawned or its base resets (survivors = agents
+// alive at that moment). A group deleted without going through a despawn path is counted as
+// wiped out - SCR_AIGroup deletes itself once its last member is gone.
+// Closed records are appended to $profile:IPC_ExtendedWaveMetrics.csv; the per base / group
+// type aggregate is part of "#ipcext stats".
+//------------------------------------------------------------------------------------------------
+
+class IPC_WaveGroupRecord
+{
+	SCR_AIGroup m_Group;
+	string m_sBaseName;
+	string m_sFactionKey;
+	string m_sGroupType;
+	int m_iWave;
+	float m_fSpawnTime;					// World time (ms)
+	float m_fContactTime = -1;			// Seconds after spawn (-1 = never)
+	float m_fIdleTime;					// Seconds
+	float m_fLastSampleTime;			// World time (ms)
+	int m_iPeakAgents;
+	int m_iAlive;
+	int m_iKills;
+}
+
+class IPC_WaveMetricsAggregate
+{
+	int m_iGroups;
+	int m_iContacted;
+	float m_fContactTimeSum;
+	int m_iKills;
+	int m_iLosses;
+	int m_iSurvivors;
+	float m_fAliveTime;
+	float m_fIdleTime;
+}
+
+class IPC_WaveMetrics
+{
+	protected static const int SAMPLE_INTERVAL = 5000;	// ms
+	protected static const string CSV_FILE_PATH = "$profile:IPC_ExtendedWaveMetrics.csv";
+
+	protected static ref IPC_WaveMetrics s_Instance;
+
+	protected ref array<ref IPC_WaveGroupRecord> m_aActive = {};
+	protected ref map<string, ref IPC_WaveMetricsAggregate> m_mAggregates = new map<string, ref IPC_WaveMetricsAggregate>();	// "<base>|<group type>"
+	protected bool m_bSampling;
+
+	//------------------------------------------------------------------------------------------------
+	static IPC_WaveMetrics GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new IPC_WaveMetrics();
+
+		return s_Instance;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Start tracking a spawned reinforcement group
+	//------------------------------------------------------------------------------------------------
+	void OnGroupSpawned(notnull SCR_AIGroup group, string baseName, string factionKey, int wave, string groupType)
+	{
+		IPC_WaveGroupRecord record = new IPC_WaveGroupRecord();
+		record.m_Group = group;
+		record.m_sBaseName = baseName;
+		record.m_sFactionKey = factionKey;
+		record.m_iWave = wave;
+		record.m_sGroupType = groupType;
+		record.m_fSpawnTime = GetGame().GetWorld().GetWorldTime();
+		record.m_fLastSampleTime = record.m_fSpawnTime;
+		record.m_iPeakAgents = group.GetAgentsCount();
+		record.m_iAlive = record.m_iPeakAgents;
+		m_aActive.Insert(record);
+
+		if (!m_bSampling)
+		{
+			m_bSampling = true;
+			GetGame().GetCallqueue().CallLater(Sample, SAMPLE_INTERVAL, true);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Credit a player kill to the reinforcement group of the killer (if any)
+	//------------------------------------------------------------------------------------------------
+	void OnPlayerKilledBy(IEntity killer)
+	{
+		if (!killer || m_aActive.IsEmpty())
+			return;
+
+		AIControlComponent control = AIControlComponent.Cast(killer.FindComponent(AIControlComponent));
+		if (!control || !control.GetAIAgent())
+			return;
+
+		AIGroup killerGroup = control.GetAIAgent().GetParentGroup();
+		if (!killerGroup)
+			return;
+
+		foreach (IPC_WaveGroupRecord record : m_aActive)
+		{
+			if (record.m_Group == killerGroup)
+			{
+				record.m_iKills++;
+				return;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Close the records of a base whose combat ended (remaining agents count as survivors)
+	//------------------------------------------------------------------------------------------------
+	void OnBaseReset(string baseName)
+	{
+		for (int i = m_aActive.Count() - 1; i >= 0; i--)
+		{
+			IPC_WaveGroupRecord record = m_aActive[i];
+			if (record.m_sBaseName != baseName)
+				continue;
+
+			UpdateRecord(record, GetGame().GetWorld().GetWorldTime(), null);
+			Close(record);
+			m_aActive.Remove(i);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Close the record of a group that is about to be despawned (agents still alive count as survivors)
+	//------------------------------------------------------------------------------------------------
+	void OnGroupDespawned(SCR_AIGroup group)
+	{
+		if (!group)
+			return;
+
+		foreach (int i, IPC_WaveGroupRecord record : m_aActive)
+		{
+			if (record.m_Group != group)
+				continue;
+
+			UpdateRecord(record, GetGame().GetWorld().GetWorldTime(), null);
+			Close(record);
+			m_aActive.Remove(i);
+			return;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void Sample()
+	{
+		int startTick = IPC_ScriptTimer.Start();
+
+		IPC_CombatSnapshot snapshot = IPC_CombatSnapshot.Capture(false);
+		float now = snapshot.m_fTime;
+
+		for (int i = m_aActive.Count() - 1; i >= 0; i--)
+		{
+			IPC_WaveGroupRecord record = m_aActive[i];
+			UpdateRecord(record, now, snapshot);
+
+			if (record.m_iAlive > 0)
+				continue;
+
+			Close(record);
+			m_aActive.Remove(i);
+		}
+
+		if (m_aActive.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(Sample);
+			m_bSampling = false;
+		}
+
+		IPC_ScriptTimer.Stop(startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Update alive count, contact and idle time (snapshot null = count only)
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateRecord(IPC_WaveGroupRecord record, float now, IPC_CombatSnapshot snapshot)
+	{
+		float elapsed = (now - record.m_fLastSampleTime) / 1000.0;
+		record.m_fLastSampleTime = now;
+
+		if (!record.m_Group)
+		{
+			record.m_iAlive = 0;
+			return;
+		}
+
+		record.m_iAlive = record.m_Group.GetAgentsCount();
+		record.m_iPeakAgents = Math.Max(record.m_iPeakAgents, record.m_iAlive);
+
+		if (!snapshot || record.m_iAlive == 0)
+			return;
+
+		IEntity leader = record.m_Group.GetLeaderEntity();
+		vector groupPos = record.m_Group.GetOrigin();
+		if (leader)
+			groupPos = leader.GetOrigin();
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+
+		if (record.m_fContactTime < 0 && snapshot.CountAttackersInRange(groupPos, record.m_sFactionKey, config.m_fMetricsContactRange) > 0)
+			record.m_fContactTime = (now - record.m_fSpawnTime) / 1000.0;
+
+		if (snapshot.CountAttackersInRange(groupPos, record.m_sFactionKey, config.m_fMetricsIdleRange) == 0)
+			record.m_fIdleTime += elapsed;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Fold a finished record into its aggregate and append it to the CSV
+	//------------------------------------------------------------------------------------------------
+	protected void Close(IPC_WaveGroupRecord record)
+	{
+		string key = record.m_sBaseName + "|" + record.m_sGroupType;
+		IPC_WaveMetricsAggregate aggregate = m_mAggregates.Get(key);
+		if (!aggregate)
+		{
+			aggregate = new IPC_WaveMetricsAggregate();
+			m_mAggregates.Insert(key, aggregate);
+		}
+
+		float aliveTime = (record.m_fLastSampleTime - record.m_fSpawnTime) / 1000.0;
+		int losses = record.m_iPeakAgents - record.m_iAlive;
+
+		aggregate.m_iGroups++;
+		aggregate.m_iKills += record.m_iKills;
+		aggregate.m_iLosses += losses;
+		aggregate.m_iSurvivors += record.m_iAlive;
+		aggregate.m_fAliveTime += aliveTime;
+		aggregate.m_fIdleTime += record.m_fIdleTime;
+		if (record.m_fContactTime >= 0)
+		{
+			aggregate.m_iContacted++;
+			aggregate.m_fContactTimeSum += record.m_fContactTime;
+		}
+
+		WriteCsv(record, aliveTime, losses);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void WriteCsv(IPC_WaveGroupRecord record, float aliveTime, int losses)
+	{
+		bool newFile = !FileIO.FileExists(CSV_FILE_PATH);
+
+		FileHandle file = FileIO.OpenFile(CSV_FILE_PATH, FileMode.APPEND);
+		if (!file)
+			return;
+
+		if (newFile)
+			file.WriteLine("base,faction,wave,group_type,spawn_time_s,alive_s,contact_s,idle_s,peak_agents,kills,losses,survivors");
+
+		file.WriteLine(string.Format("%1,%2,%3,%4,%5,%6,%7,%8,%9,", record.m_sBaseName, record.m_sFactionKey, record.m_iWave, record.m_sGroupType,
+									 Math.Round(record.m_fSpawnTime / 1000.0), Math.Round(aliveTime), Math.Round(record.m_fContactTime),
+									 Math.Round(record.m_fIdleTime), record.m_iPeakAgents) + string.Format("%1,%2,%3", record.m_iKills, losses, record.m_iAlive));
+		file.Close();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Append per base / group type aggregates to a stats dump
+	//------------------------------------------------------------------------------------------------
+	void GetStats(notnull array<string> lines)
+	{
+		lines.Insert(string.Format("Wave metrics: %1 groups tracked", m_aActive.Count()));
+
+		foreach (string key, IPC_WaveMetricsAggregate aggregate : m_mAggregates)
+		{
+			string contact = "never";
+			if (aggregate.m_iContacted > 0)
+				contact = string.Format("%1s avg (%2/%3)", Math.Round(aggregate.m_fContactTimeSum / aggregate.m_iContacted), aggregate.m_iContacted, aggregate.m_iGroups);
+
+			float idleShare;
+			if (aggregate.m_fAliveTime > 0)
+				idleShare = aggregate.m_fIdleTime / aggregate.m_fAliveTime * 100;
+
+			lines.Insert(string.Format("  %1: %2 groups | contact %3 | kills %4 | losses %5 | survivors %6 | idle %7 pct",
+				key, aggregate.m_iGroups, contact, aggregate.m_iKills, aggregate.m_iLosses, aggregate.m_iSurvivors, Math.Round(idleShare)));
+		}
+	}
+}
@@ -1,11 +1,16 @@
 //------------------------------------------------------------------------------------------------
 // IPC AI Combat Extended - Modded Attacker Spawn Component
 // Extends base IPC mod to modify attacking friendly spawn behavior
-// Requirements: 100s respawn time, 1 groups per spawn point
+// Requirements: 90s respawn time, 1 group per spawn point
+//               (m_iAttackerRespawnTime / m_iAttackerGroupCount from IPC_ExtendedConfig, applied
+//               live on reload; scaled at runtime by IPC_PopulationController when enabled)
+// Respawns are deferred while m_iAttackerSaturationCap friendly AI already stand at the objective
 //------------------------------------------------------------------------------------------------
 
 modded class IPC_AutonomousCaptureSpawnPointComponent : IPC_SpawnPointComponent
 {
+	protected bool m_bSaturationDeferred;		// Last CanRespawnNow() deferred (log on change only)
+
 	//------------------------------------------------------------------------------------------------
 	//! Override initialization to set custom spawn parameters for attacking friendlies
 	//------------------------------------------------------------------------------------------------
@@ -14,11 +19,53 @@ modded class IPC_AutonomousCaptureSpawnPointComponent : IPC_SpawnPointComponent
 		super.EOnInit(owner);
 
 		// Set spawn parameters for attacking friendly forces
-		// User requirement: 100s respawn (was 120s), 1 group (was 2)
-		m_iRespawnPeriod = 90;   // Respawn time in seconds
-		m_iNum = 1;              // Number of SpawnUnits() calls
+		ApplyExtendedConfig(IPC_ExtendedConfig.GetInstance());
 
 		PrintFormat("[IPC Extended] Attacker spawn point initialized - Respawn: %1s, Groups: %2",
 					m_iRespawnPeriod, m_iNum);
 	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Apply attacker spawn parameters from runtime configuration
+	//------------------------------------------------------------------------------------------------
+	override void ApplyExtendedConfig(IPC_ExtendedConfig config)
+	{
+		// User requirement: 90s respawn (was 120s), 1 group (was 2) - the configured values before population scaling
+		IPC_PopulationController controller = IPC_PopulationController.GetInstance();
+		m_iRespawnPeriod = controller.ScaleRespawnPeriod(config.m_iAttackerRespawnTime);	// Respawn time in seconds
+		m_iNum = controller.ScaleGroupCount(config.m_iAttackerGroupCount);				// Number of SpawnUnits() calls
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Attacker respawns count against the attacker share of the AI budget
+	//------------------------------------------------------------------------------------------------
+	override IPC_EAIBudgetSubsystem GetAIBudgetSubsystem()
+	{
+		return IPC_EAIBudgetSubsystem.ATTACKERS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Defer the respawn while the objective is already crowded with friendly AI (shared density grid)
+	//! Logged when the deferral starts and ends (every deferred check in debug mode)
+	//------------------------------------------------------------------------------------------------
+	override bool CanRespawnNow()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		if (!config.m_bAttackerSaturationGate || !m_nearBase || !m_Faction)
+			return true;
+
+		int count;
+		bool saturated = IPC_AIDensityMap.GetInstance().IsSaturated(m_nearBase.GetOwner().GetOrigin(), m_Faction.GetFactionKey(),
+																	  config.m_fAttackerSaturationRadius, config.m_iAttackerSaturationCap, count);
+
+		if (saturated && (!m_bSaturationDeferred || config.m_bDebugMode))
+			PrintFormat("[IPC Extended] Attacker spawns at %1 deferred - %2 %3 AI already within %4m of the objective (cap %5)",
+						m_nearBase.GetOwner().GetName(), count, m_Faction.GetFactionKey(), config.m_fAttackerSaturationRadius, config.m_iAttackerSaturationCap);
+		else if (!saturated && m_bSaturationDeferred)
+			PrintFormat("[IPC Extended] Attacker spawns at %1 resumed - %2 %3 AI within %4m of the objective (cap %5)",
+						m_nearBase.GetOwner().GetName(), count, m_Faction.GetFactionKey(), config.m_fAttackerSaturationRadius, config.m_iAttackerSaturationCap);
+
+		m_bSaturationDeferred = saturated;
+		return !saturated;
+	}
 }
@@ -2,9 +2,11 @@
 // IPC AI Combat Extended - Modded Defender Spawn Component
 // Extends base IPC mod to add reinforcement behavior to defending enemy spawns
 //
-// Base behavior: 180s respawn time, 2 groups per spawn point
+// Base behavior: m_iDefenderRespawnTime (180 s) respawn time, m_iDefenderGroupCount (2) groups per
+//                spawn point - both scaled at runtime by IPC_PopulationController when enabled
 // Reinforcement behavior: When players attack this base for 5+ minutes,
 //                         spawn larger reinforcement waves with increased spawn dispersion
+// Tunables: IPC_ExtendedConfig (server profile JSON, applied live on reload)
 //------------------------------------------------------------------------------------------------
 
 modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
@@ -13,48 +15,38 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	// REINFORCEMENT TRACKING
 	//------------------------------------------------------------------------------------------------
 
-	protected WorldTimestamp m_tCombatStartTime;			// When combat started at this base
-	protected bool m_bReinforcementActive = false;			// Is reinforcement mode active
-	protected int m_iReinforcementWave = 0;					// Current wave number (0=none, 1=first, 2=second)
-	protected WorldTimestamp m_tLastReinforcementTime;		// When last reinforcement spawned
+	// Wave ladder and grace period state (pure data, shared with the trace replay)
+	protected ref IPC_BaseDecisionState m_DecisionState = new IPC_BaseDecisionState();
 	protected bool m_bIsReinforcementCoordinator = false;	// Is this spawn point the coordinator for this base?
 	protected bool m_bCoordinatorInitialized = false;		// Has coordinator selection been done?
+	protected int m_iDeferredWave;							// Wave currently waiting for pool points (0 = none)
 
 	// Reinforcement group tracking (for cleanup)
 	protected ref array<SCR_AIGroup> m_aReinforcementGroups = new array<SCR_AIGroup>();
+	protected ref array<ref IPC_StuckRecord> m_aStuckRecords = {};
+
+	// Per-base update channels (IPC_BaseChannelScheduler)
+	protected ref IPC_BaseChannels m_Channels = new IPC_BaseChannels();
+	protected bool m_bChannelsRegistered;
+	protected bool m_bKeepDefendersActive = true;			// Last frontline channel result (applied in UpdateTarget)
 
 	// Helicopter tracking (for cleanup)
 	protected ref array<IEntity> m_aReinforcementHelicopters = new array<IEntity>();
 
-	// Frontline detection for auto-despawn
-	protected WorldTimestamp m_tInactiveSince;					// When base became inactive
-	protected const int INACTIVE_GRACE_PERIOD = 600;			// 10 minutes before despawn
-	protected const float FRONTLINE_RANGE = 2000.0;				// Enemy base within 5km = frontline
-
-	// Reinforcement configuration
-	protected const int REINFORCEMENT_WAVE1_THRESHOLD = 300;	// 5 minutes
-	protected const int REINFORCEMENT_WAVE2_THRESHOLD = 600;	// 10 minutes
-	protected const int REINFORCEMENT_WAVE3_THRESHOLD = 900;	// 15 minutes
-	protected const int REINFORCEMENT_WAVE4_THRESHOLD = 1200;	// 20 minutes
-	protected const float COMBAT_DETECTION_RANGE = 300.0;		// Distance to detect player activity
-	protected const int CHECK_INTERVAL = 30000;					// Check every 30 seconds (not 5!)
-
-	// Normal spawn parameters
-	protected const int NORMAL_RESPAWN_TIME = 180;
-	protected const int NORMAL_GROUP_COUNT = 2;
+	// Waypoints shared by all groups of the current wave, per approach ("" = ring spawn, else source base ID)
+	protected ref map<string, ref array<AIWaypoint>> m_mWaveWaypoints = new map<string, ref array<AIWaypoint>>();
+	protected float m_fNextWaypointSlot;					// World time (ms) of the next free staggered assignment
+	protected ref array<AIWaypoint> m_aRetiredWaypoints = {};	// Waypoints of ended waves, deleted once no tracked group uses them
 
-	// Reinforcement spawn parameters
-	protected const int REINFORCEMENT_GROUP_COUNT = 1;			// Number of reinforcement groups per wave
-	protected const float REINFORCEMENT_SPAWN_RADIUS = 200.0;	// Spawn dispersion radius (100m base + 200m spread = 100-300m total)
+	// Idle posture (IPC_DefenderPosture): patrol waypoints stashed while the group holds position
+	protected bool m_bIdlePosture;
+	protected SCR_AIGroup m_IdleGroup;							// Group the waypoints were taken from
+	protected ref array<AIWaypoint> m_aStashedWaypoints = {};
 
 	// Helicopter configuration
 	protected const string HELICOPTER_PREFAB_MI8MT = "{3C6B3ED0C3AC30D5}Prefabs/Vehicles/Helicopters/Mi8MT/Mi8MT_armed_gunship_HE.et";
-	protected const float HELICOPTER_SPAWN_DISTANCE = 1500.0;	// Distance from base to spawn helicopter (1.5km)
-	protected const float HELICOPTER_SPAWN_ALTITUDE = 200.0;	// Altitude above terrain to spawn helicopter
 
-	// Debug mode configuration - Set to true for fast testing, false for normal gameplay
-	protected const bool DEBUG_MODE = false;					// CHANGE TO true FOR TESTING
-	protected const int DEBUG_WAVE_INTERVAL = 60;				// 1 minute intervals in debug mode
+	// All other tunables (wave thresholds, ranges, group counts, debug mode) live in IPC_ExtendedConfig
 
 	//------------------------------------------------------------------------------------------------
 	//! Override initialization to set custom spawn parameters
@@ -64,12 +56,12 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		super.EOnInit(owner);
 
 		// Set normal spawn parameters
-		m_iRespawnPeriod = NORMAL_RESPAWN_TIME;
-		m_iNum = NORMAL_GROUP_COUNT;
+		ApplyExtendedConfig(IPC_ExtendedConfig.GetInstance());
 
-		if (DEBUG_MODE)
+		if (IsDebugMode())
 		{
-			PrintFormat("[IPC Extended] Defender spawn point initialized - DEBUG MODE ENABLED (Wave intervals: 1min, 2min, 3min, 4min)", LogLevel.NORMAL);
+			PrintFormat("[IPC Extended] Defender spawn point initialized - DEBUG MODE ENABLED (Wave interval: %1s)",
+						IPC_ExtendedConfig.GetInstance().m_iDebugWaveInterval);
 		}
 		else
 		{
@@ -80,6 +72,24 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		// Will be triggered after first PrepareBase() call
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Apply defender spawn parameters from runtime configuration (init, live reload, population controller)
+	//------------------------------------------------------------------------------------------------
+	override void ApplyExtendedConfig(IPC_ExtendedConfig config)
+	{
+		IPC_PopulationController controller = IPC_PopulationController.GetInstance();
+		m_iRespawnPeriod = controller.ScaleRespawnPeriod(config.m_iDefenderRespawnTime);
+		m_iNum = controller.ScaleGroupCount(config.m_iDefenderGroupCount);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Is debug mode enabled (fast wave intervals, verbose logging)
+	//------------------------------------------------------------------------------------------------
+	protected bool IsDebugMode()
+	{
+		return IPC_ExtendedConfig.GetInstance().m_bDebugMode;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Override PrepareBase to trigger coordinator initialization after base is known
 	//------------------------------------------------------------------------------------------------
@@ -87,20 +97,26 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	{
 		super.PrepareBase();
 
+		if (m_nearBase && !m_bChannelsRegistered)
+		{
+			m_bChannelsRegistered = true;
+			IPC_BaseChannelScheduler.GetInstance().Register(this);
+		}
+
 		// After base is prepared, initialize coordinator role if not done yet
 		if (m_nearBase && !m_bCoordinatorInitialized)
 		{
 			m_bCoordinatorInitialized = true;  // Prevent multiple initialization attempts
-			// Use a delay to let other spawn points also call PrepareBase
-			GetGame().GetCallqueue().CallLater(InitializeReinforcementCoordinator, 5000, false);
+			// Delayed on the task runner to let other spawn points also call PrepareBase (cancelled if we are deleted)
+			IPC_TaskRunner.GetInstance().Add(new IPC_CoordinatorElectionTask(this));
 			PrintFormat("[IPC Reinforcement] Scheduled coordinator initialization for spawn point at %1", m_nearBase.GetOwner().GetName());
 		}
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Initialize reinforcement coordinator role (called after delay to allow other spawn points to register)
+	//! Initialize reinforcement coordinator role (IPC_CoordinatorElectionTask, after a delay to allow other spawn points to register)
 	//------------------------------------------------------------------------------------------------
-	protected void InitializeReinforcementCoordinator()
+	void InitializeReinforcementCoordinator()
 	{
 		if (!m_nearBase)
 			return;
@@ -144,8 +160,12 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 			PrintFormat("[IPC Reinforcement] Spawn point %1 is COORDINATOR for base %2",
 						GetOwner().GetName(), m_nearBase.GetOwner().GetName());
 
-			// Only the coordinator runs periodic checks (every 30 seconds)
-			GetGame().GetCallqueue().CallLater(CheckReinforcements, CHECK_INTERVAL, true);
+			// Only coordinators are checked - centrally by the director (every 30 seconds by default)
+			IPC_ReinforcementDirector.GetInstance().Register(this);
+
+			// Start validating spawn/waypoint candidates and warming source routes in idle frames long before the first wave
+			IPC_SpawnRingCache.GetInstance().Prepare(m_nearBase);
+			IPC_RouteCache.GetInstance().Prepare(m_nearBase);
 		}
 		else
 		{
@@ -154,6 +174,14 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		}
 	}
 
+	//------------------------------------------------------------------------------------------------
+	//! Get defending faction
+	//------------------------------------------------------------------------------------------------
+	Faction GetDefenderFaction()
+	{
+		return m_Faction;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Get the nearby base (for coordinator detection)
 	//------------------------------------------------------------------------------------------------
@@ -163,347 +191,376 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Get wave threshold based on debug mode
+	//! Is this spawn point the reinforcement coordinator of its base
 	//------------------------------------------------------------------------------------------------
-	protected int GetWaveThreshold(int waveNumber)
+	bool IsReinforcementCoordinator()
 	{
-		if (DEBUG_MODE)
+		return m_bIsReinforcementCoordinator;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get wave ladder / grace period state (read-only use by monitoring)
+	//------------------------------------------------------------------------------------------------
+	IPC_BaseDecisionState GetDecisionState()
+	{
+		return m_DecisionState;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Is the current defender group holding position without patrol waypoints
+	//------------------------------------------------------------------------------------------------
+	bool IsIdlePosture()
+	{
+		return m_bIdlePosture && m_Group && m_Group == m_IdleGroup;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stash (idle) or restore (patrol) the waypoints of the current defender group
+	//------------------------------------------------------------------------------------------------
+	void SetIdlePosture(bool idle)
+	{
+		// Group died or respawned since going idle - the stash belongs to the old group
+		if (m_bIdlePosture && (!m_Group || m_Group != m_IdleGroup))
 		{
-			// In debug mode: 1 minute intervals (1min, 2min, 3min, 4min)
-			return waveNumber * DEBUG_WAVE_INTERVAL;
+			m_aStashedWaypoints.Clear();
+			m_IdleGroup = null;
+			m_bIdlePosture = false;
 		}
 
-		// Normal mode: 5, 10, 15, 20 minutes
-		switch (waveNumber)
+		if (!m_Group || idle == m_bIdlePosture)
+			return;
+
+		if (idle)
 		{
-			case 1: return REINFORCEMENT_WAVE1_THRESHOLD;
-			case 2: return REINFORCEMENT_WAVE2_THRESHOLD;
-			case 3: return REINFORCEMENT_WAVE3_THRESHOLD;
-			case 4: return REINFORCEMENT_WAVE4_THRESHOLD;
+			m_Group.GetWaypoints(m_aStashedWaypoints);
+			foreach (AIWaypoint waypoint : m_aStashedWaypoints)
+			{
+				m_Group.RemoveWaypoint(waypoint);
+			}
+
+			m_IdleGroup = m_Group;
 		}
+		else
+		{
+			foreach (AIWaypoint waypoint : m_aStashedWaypoints)
+			{
+				if (waypoint)
+					m_Group.AddWaypoint(waypoint);
+			}
 
-		return 999999; // Invalid wave
+			m_aStashedWaypoints.Clear();
+			m_IdleGroup = null;
+		}
+
+		m_bIdlePosture = idle;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Despawn all reinforcement groups and helicopters from previous waves
+	//! Count alive AI in tracked reinforcement groups
 	//------------------------------------------------------------------------------------------------
-	protected void DespawnPreviousWaveGroups()
+	int GetReinforcementAICount()
 	{
-		if (DEBUG_MODE)
+		int count;
+		foreach (SCR_AIGroup group : m_aReinforcementGroups)
+		{
+			if (group)
+				count += group.GetAgentsCount();
+		}
+
+		return count;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get wave threshold based on debug mode
+	//! Normal mode: 5, 10, 15, 20 minutes by default; debug mode: one debug interval per wave
+	//------------------------------------------------------------------------------------------------
+	protected int GetWaveThreshold(int waveNumber)
+	{
+		return IPC_ExtendedConfig.GetInstance().GetWaveThreshold(waveNumber);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Despawn reinforcement groups and helicopters from previous waves
+	//! \param groupCount / helicopterCount oldest entries to despawn (-1 = all); entries added by the
+	//! wave being admitted come after them and stay
+	//------------------------------------------------------------------------------------------------
+	protected void DespawnPreviousWaveGroups(int groupCount = -1, int helicopterCount = -1)
+	{
+		if (groupCount < 0)
+			groupCount = m_aReinforcementGroups.Count();
+
+		if (helicopterCount < 0)
+			helicopterCount = m_aReinforcementHelicopters.Count();
+
+		if (IsDebugMode())
 		{
 			PrintFormat("[IPC Reinforcement DEBUG] Despawning previous wave groups (%1 groups, %2 helicopters)",
-						m_aReinforcementGroups.Count(), m_aReinforcementHelicopters.Count());
+						groupCount, helicopterCount);
 		}
 
-		// Despawn all reinforcement groups
-		foreach (SCR_AIGroup group : m_aReinforcementGroups)
+		// Deleted over several frames on the task runner (one entity per step)
+		IPC_DespawnTask despawnTask = new IPC_DespawnTask();
+		for (int i = groupCount - 1; i >= 0; i--)
 		{
-			if (group && !group.IsDeleted())
-			{
-				array<AIAgent> units = {};
-				group.GetAgents(units);
-				RplComponent.DeleteRplEntity(group, false);
-			}
+			// Close the wave metrics now, while the survivors can still be counted
+			SCR_AIGroup group = m_aReinforcementGroups[i];
+			IPC_WaveMetrics.GetInstance().OnGroupDespawned(group);
+			despawnTask.AddEntity(group);
+			m_aReinforcementGroups.RemoveOrdered(i);
 		}
-		m_aReinforcementGroups.Clear();
 
-		// Despawn all helicopters
-		foreach (IEntity helicopter : m_aReinforcementHelicopters)
+		// No previous group left to follow them
+		RetireWaveWaypoints();
+		DeleteUnusedWaypoints();
+
+		for (int j = helicopterCount - 1; j >= 0; j--)
 		{
-			if (helicopter && !helicopter.IsDeleted())
-			{
-				RplComponent.DeleteRplEntity(helicopter, false);
-			}
+			IEntity helicopter = m_aReinforcementHelicopters[j];
+			IPC_WaveMetrics.GetInstance().OnGroupDespawned(GetCrewGroup(helicopter));
+			despawnTask.AddEntity(helicopter);
+			m_aReinforcementHelicopters.RemoveOrdered(j);
 		}
-		m_aReinforcementHelicopters.Clear();
 
-		if (DEBUG_MODE)
+		IPC_TaskRunner.GetInstance().Add(despawnTask);
+
+		if (IsDebugMode())
 		{
-			PrintFormat("[IPC Reinforcement DEBUG] Previous wave cleanup complete");
+			PrintFormat("[IPC Reinforcement DEBUG] Previous wave cleanup queued");
 		}
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Periodic check for reinforcements (called every 30 seconds, ONLY by coordinator)
+	//! Periodic reinforcement check (called by IPC_ReinforcementDirector every 30 seconds, ONLY for coordinators)
+	//! Updates the wave ladder from the shared snapshot; the director decides whether a due wave spawns
+	//! \return wave that is due at this base (0 = none)
 	//------------------------------------------------------------------------------------------------
-	protected void CheckReinforcements()
+	int EvaluateReinforcements(IPC_CombatSnapshot snapshot)
 	{
 		// Safety check: Only coordinators should run this
 		if (!m_bIsReinforcementCoordinator)
-			return;
+			return 0;
 
 		// Only check reinforcement logic if we have a nearby base to defend
 		if (!m_nearBase)
-			return;
+			return 0;
+
+		IPC_TraceRecorder.RecordCheck(snapshot, this);
+
+		// Detection channel: the wave ladder cannot move while no attacker is near and no combat is tracked
+		if (m_DecisionState.m_bCombatActive || IPC_BaseDecisionState.IsUnderAttack(snapshot, snapshot.FindBaseIndex(m_nearBase)))
+			m_Channels.MarkDirty(IPC_EBaseChannel.DETECTION);
+
+		if (!m_Channels.Consume(IPC_EBaseChannel.DETECTION, snapshot.m_fTime))
+			return 0;
+
+		int startTick = IPC_ScriptTimer.Start();
 
 		// Check if players are actively attacking this base
-		bool combatActive = DetectCombatAtBase();
+		bool combatActive = DetectCombatAtBase(snapshot);
 
 		// Update reinforcement state based on combat duration
-		UpdateReinforcementState(combatActive);
+		int dueWave = UpdateReinforcementState(combatActive, snapshot.m_fTime);
 
-		// Cleanup dead reinforcement groups
-		CleanupDeadReinforcementGroups();
+		IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.DETECTION, startTick);
+		return dueWave;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Detect if players are attacking this defended base
+	//! Threat at this base: alive attackers within detection range
 	//------------------------------------------------------------------------------------------------
-	protected bool DetectCombatAtBase()
+	float GetThreat(IPC_CombatSnapshot snapshot)
 	{
-		if (!m_nearBase)
-			return false;
+		if (!m_nearBase || !m_Faction)
+			return 0;
 
-		// Check if base is enemy-controlled (we're defending it)
+		// Attackers are counted against the base owner - no threat once the base is lost
 		Faction baseFaction = m_nearBase.GetFaction();
 		if (!baseFaction || baseFaction != m_Faction)
-			return false; // Base captured or wrong faction
-
-		// Check for nearby enemy players
-		vector basePos = m_nearBase.GetOwner().GetOrigin();
+			return 0;
 
-		PlayerManager playerManager = GetGame().GetPlayerManager();
-		if (!playerManager)
-			return false;
-
-		array<int> playerIds = {};
-		playerManager.GetPlayers(playerIds);
-
-		foreach (int playerId : playerIds)
-		{
-			IEntity player = playerManager.GetPlayerControlledEntity(playerId);
-			if (!player)
-				continue;
+		IPC_BaseProximity proximity = snapshot.GetBaseProximity(snapshot.FindBaseIndex(m_nearBase));
+		if (!proximity)
+			return 0;
 
-			// Check if player is alive and within combat range
-			CharacterControllerComponent controller = CharacterControllerComponent.Cast(player.FindComponent(CharacterControllerComponent));
-			if (!controller || controller.IsDead())
-				continue;
-
-			// Check if player is enemy faction
-			SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(player);
-			if (!character)
-				continue;
+		return proximity.m_iAttackers;
+	}
 
-			Faction playerFaction = character.GetFaction();
-			if (!playerFaction || playerFaction == m_Faction)
-				continue; // Same faction, not an attacker
+	//------------------------------------------------------------------------------------------------
+	//! Detect if players are attacking this defended base
+	//------------------------------------------------------------------------------------------------
+	protected bool DetectCombatAtBase(IPC_CombatSnapshot snapshot)
+	{
+		if (!m_nearBase || !m_Faction)
+			return false;
 
-			float distSq = vector.DistanceSq(player.GetOrigin(), basePos);
-			if (distSq < COMBAT_DETECTION_RANGE * COMBAT_DETECTION_RANGE)
-				return true; // Enemy player attacking our base
-		}
+		// Check if base is enemy-controlled (we're defending it)
+		Faction baseFaction = m_nearBase.GetFaction();
+		if (!baseFaction || baseFaction != m_Faction)
+			return false; // Base captured or wrong faction
 
-		return false;
+		// Check for nearby alive enemy players (shared proximity sweep of the snapshot)
+		return IPC_BaseDecisionState.IsUnderAttack(snapshot, snapshot.FindBaseIndex(m_nearBase));
 	}
 
 	//------------------------------------------------------------------------------------------------
 	//! Update reinforcement state based on combat activity
+	//! \return wave that is due now (0 = none)
 	//------------------------------------------------------------------------------------------------
-	protected void UpdateReinforcementState(bool combatActive)
+	protected int UpdateReinforcementState(bool combatActive, float currentTime)
 	{
-		ChimeraWorld world = GetOwner().GetWorld();
-		if (!world)
-			return;
-
-		WorldTimestamp currentTime = world.GetServerTimestamp();
+		bool combatStarted;
+		bool combatEnded;
+		int dueWave = m_DecisionState.UpdateCombat(combatActive, currentTime, combatStarted, combatEnded);
 
 		// Start tracking combat
-		if (combatActive && !m_bReinforcementActive)
+		if (combatStarted)
 		{
-			m_tCombatStartTime = currentTime;
-			m_bReinforcementActive = true;
-
-			if (DEBUG_MODE)
-				PrintFormat("[IPC Reinforcement DEBUG] Combat detected at %1 - DEBUG MODE ACTIVE (1 min intervals)",
-							m_nearBase.GetOwner().GetName());
+			if (IsDebugMode())
+				PrintFormat("[IPC Reinforcement DEBUG] Combat detected at %1 - DEBUG MODE ACTIVE (%2s intervals)",
+							m_nearBase.GetOwner().GetName(), GetWaveThreshold(1));
 			else
 				PrintFormat("[IPC Reinforcement] Combat detected at %1 - tracking started",
 							m_nearBase.GetOwner().GetName());
 		}
 
 		// Reset if combat stopped
-		if (!combatActive && m_bReinforcementActive)
+		if (combatEnded)
 		{
 			ResetReinforcementState();
 
-			if (DEBUG_MODE)
+			if (IsDebugMode())
 				PrintFormat("[IPC Reinforcement DEBUG] Combat ended at %1 - reset", m_nearBase.GetOwner().GetName());
 			else
 				PrintFormat("[IPC Reinforcement] Combat ended at %1 - reset", m_nearBase.GetOwner().GetName());
 
-			return;
+			return 0;
 		}
 
-		// Check if reinforcement threshold reached
-		if (m_bReinforcementActive)
+		// Debug mode: Display time until next wave
+		if (IsDebugMode() && m_DecisionState.m_bCombatActive)
 		{
-			float combatDuration = currentTime.DiffMilliseconds(m_tCombatStartTime) / 1000.0;
-
-			// Prevent re-triggering within cooldown period
-			if (m_tLastReinforcementTime)
-			{
-				float timeSinceLastReinforcement = currentTime.DiffMilliseconds(m_tLastReinforcementTime) / 1000.0;
-				if (timeSinceLastReinforcement < 10.0)
-					return; // Still in cooldown
-			}
-
-			// Check waves in priority order (Wave 3 → Wave 2 → Wave 1)
-			// Use GetWaveThreshold() to get correct timing based on debug mode
-			// NOTE: Wave 4 (helicopter) is temporarily disabled for testing
-
-			// Wave 4 - DISABLED FOR TESTING
-			//if (m_iReinforcementWave < 4 && combatDuration >= GetWaveThreshold(4))
-			//{
-			//	TriggerReinforcements(4);
-			//}
-			// Wave 3
-			if (m_iReinforcementWave < 3 && combatDuration >= GetWaveThreshold(3))
+			int currentWave = m_DecisionState.m_iWave;
+			int nextWave = currentWave + 1;
+			if (nextWave <= IPC_BaseDecisionState.MAX_GROUND_WAVE) // Only up to wave 3 (wave 4 disabled)
 			{
-				TriggerReinforcements(3);
-			}
-			// Wave 2
-			else if (m_iReinforcementWave < 2 && combatDuration >= GetWaveThreshold(2))
-			{
-				TriggerReinforcements(2);
-			}
-			// Wave 1
-			else if (m_iReinforcementWave < 1 && combatDuration >= GetWaveThreshold(1))
-			{
-				TriggerReinforcements(1);
-			}
-
-			// Debug mode: Display time until next wave
-			if (DEBUG_MODE)
-			{
-				int nextWave = m_iReinforcementWave + 1;
-				if (nextWave <= 3) // Only up to wave 3 (wave 4 disabled)
+				float combatDuration = m_DecisionState.GetCombatDuration(currentTime);
+				float timeUntilNextWave = GetWaveThreshold(nextWave) - combatDuration;
+				if (timeUntilNextWave > 0)
 				{
-					float timeUntilNextWave = GetWaveThreshold(nextWave) - combatDuration;
-					if (timeUntilNextWave > 0)
-					{
-						PrintFormat("[IPC Reinforcement DEBUG] Current wave: %1 | Time until Wave %2: %3 seconds | Combat duration: %4s",
-									m_iReinforcementWave, nextWave, timeUntilNextWave, combatDuration);
-					}
+					PrintFormat("[IPC Reinforcement DEBUG] Current wave: %1 | Time until Wave %2: %3 seconds | Combat duration: %4s",
+								currentWave, nextWave, timeUntilNextWave, combatDuration);
 				}
 			}
 		}
+
+		// Reinforcement threshold reached (wave 4 helicopter is temporarily disabled)
+		return dueWave;
 	}
 
 	//------------------------------------------------------------------------------------------------
 	//! Trigger reinforcement wave - manually spawn additional units independent of parent mod
+	//! Called by IPC_ReinforcementDirector when the wave is granted, with the snapshot of its tick
+	//! \return true if the wave spawned (charged to the director's per-tick budget)
 	//------------------------------------------------------------------------------------------------
-	protected void TriggerReinforcements(int wave)
+	bool TriggerReinforcements(int wave, notnull IPC_CombatSnapshot snapshot)
+	{
+		int startTick = IPC_ScriptTimer.Start();
+		bool spawned = SpawnReinforcementWave(wave, snapshot);
+		IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.SPAWNING, startTick);
+		return spawned;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Pay for and spawn a granted wave (helicopter, combined force or single group type)
+	//! \return false if nothing spawned (pool too low, AI budget denied or every spawn failed)
+	//------------------------------------------------------------------------------------------------
+	protected bool SpawnReinforcementWave(int wave, IPC_CombatSnapshot snapshot)
 	{
 		ChimeraWorld world = GetOwner().GetWorld();
 		if (!world)
 		{
 			Print("[IPC Reinforcement] ERROR: No world in TriggerReinforcements", LogLevel.ERROR);
-			return;
+			return false;
 		}
 
-		// Debug mode: Despawn previous wave before spawning new one
-		if (DEBUG_MODE)
+		// Pay for the whole wave up front - defer it to a later check if the faction pool is too low
+		int waveCost = GetWaveCost(wave);
+		if (!IPC_ReinforcementPool.GetInstance().TryConsume(m_Faction, waveCost, wave == m_iDeferredWave))
 		{
-			DespawnPreviousWaveGroups();
+			m_iDeferredWave = wave;
+			PrintFormat("[IPC Reinforcement] WAVE %1 at %2 deferred - reinforcement pool too low (cost: %3, available: %4)",
+						wave, m_nearBase.GetOwner().GetName(), waveCost, Math.Floor(IPC_ReinforcementPool.GetInstance().GetPoints(m_Faction)));
+			return false;
 		}
 
-		m_tLastReinforcementTime = world.GetServerTimestamp();
-		m_iReinforcementWave = wave;
+		m_iDeferredWave = 0;
+
+		// The ladder only advances once something spawned (AdmitWave) - a refused wave stays due
+		int previousGroups = m_aReinforcementGroups.Count();
+		int previousHelicopters = m_aReinforcementHelicopters.Count();
 
 		string baseName = m_nearBase.GetOwner().GetName();
 
 		// Handle Wave 4 - Armed helicopter with crew
 		if (wave == 4)
 		{
-			if (DEBUG_MODE)
-				PrintFormat("[IPC Reinforcement DEBUG] WAVE 4 (4min) triggering at %1 - spawning helicopter", baseName);
+			if (IsDebugMode())
+				PrintFormat("[IPC Reinforcement DEBUG] WAVE 4 (%1s) triggering at %2 - spawning helicopter", GetWaveThreshold(4), baseName);
 			else
-				PrintFormat("[IPC Reinforcement] WAVE 4 (20min) triggering at %1 - spawning helicopter", baseName);
+				PrintFormat("[IPC Reinforcement] WAVE 4 (%1min) triggering at %2 - spawning helicopter", GetWaveThreshold(4) / 60, baseName);
 
-			int successfulSpawns = 0;
-
-			// Spawn armed helicopter (Mi-8MT) - TESTING: Just helicopter, no ground team
-			IEntity helicopter = SpawnArmedHelicopter();
-			if (helicopter)
+			// Crew must fit in the helicopter share of the AI budget, next to the crews still flying virtually
+			IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+			int crewReserve = config.m_iHelicopterCrewSize * (IPC_VirtualHelicopter.GetInstance().GetCount() + 1);
+			if (!IPC_AIBudget.GetInstance().CanSpawn(IPC_EAIBudgetSubsystem.HELICOPTER_CREW, crewReserve))
 			{
-				PrintFormat("[IPC Reinforcement] Helicopter spawned, checking for compartment manager...");
+				IPC_ReinforcementPool.GetInstance().Refund(m_Faction, waveCost);
+				return false;
+			}
 
-				// Try to get the vehicle's compartment manager
-				SCR_BaseCompartmentManagerComponent compartmentMgr = SCR_BaseCompartmentManagerComponent.Cast(
-					helicopter.FindComponent(SCR_BaseCompartmentManagerComponent));
+			vector basePos = m_nearBase.GetOwner().GetOrigin();
+			vector spawnPos = FindHelicopterSpawnPosition(basePos, config.m_fHelicopterSpawnDistance, config.m_fHelicopterSpawnAltitude);
 
-				if (compartmentMgr)
-				{
-					PrintFormat("[IPC Reinforcement] Found compartment manager, attempting to spawn default occupants...");
-
-					// Try to spawn default crew defined in the vehicle prefab
-					if (compartmentMgr.SpawnDefaultOccupants(ECompartmentType.PILOT | ECompartmentType.TURRET))
-					{
-						successfulSpawns++;
-						PrintFormat("[IPC Reinforcement] Wave 4 helicopter spawned with default crew");
-					}
-					else
-					{
-						PrintFormat("[IPC Reinforcement] WARNING: SpawnDefaultOccupants returned false");
-						successfulSpawns++; // Still count helicopter
-					}
-				}
-				else
-				{
-					PrintFormat("[IPC Reinforcement] WARNING: Helicopter has no compartment manager");
-					successfulSpawns++; // Still count helicopter
-				}
-			}
-			else
+			// Fly the approach virtually - the airframe only spawns near the AO (MaterializeHelicopter)
+			if (config.m_bVirtualHelicopterApproach)
 			{
-				PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn helicopter");
+				IPC_VirtualHelicopter.GetInstance().Start(this, spawnPos, basePos, m_Faction, waveCost);
+				AdmitWave(wave, previousGroups, previousHelicopters);
+				return true;
 			}
 
-			if (successfulSpawns > 0)
-			{
-				PrintFormat("[IPC Reinforcement] Successfully spawned Wave 4 reinforcements (%1 elements) at %2",
-							successfulSpawns, baseName);
-				BroadcastReinforcementAlert(baseName, wave);
-			}
-			else
+			if (SpawnHelicopterWave(spawnPos))
 			{
-				PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn any Wave 4 reinforcements at %1", baseName);
+				AdmitWave(wave, previousGroups, previousHelicopters);
+				return true;
 			}
 
-			return;
+			IPC_ReinforcementPool.GetInstance().Refund(m_Faction, waveCost);
+			return false;
 		}
 
 		// Handle Wave 3 - Combined force (SQUAD_RIFLE + FIRETEAM)
 		if (wave == 3)
 		{
-			if (DEBUG_MODE)
-				PrintFormat("[IPC Reinforcement DEBUG] WAVE 3 (3min) triggering at %1 - spawning combined force (SQUAD_RIFLE + FIRETEAM)", baseName);
+			if (IsDebugMode())
+				PrintFormat("[IPC Reinforcement DEBUG] WAVE 3 (%1s) triggering at %2 - spawning combined force (SQUAD_RIFLE + FIRETEAM)", GetWaveThreshold(3), baseName);
 			else
-				PrintFormat("[IPC Reinforcement] WAVE 3 (15min) triggering at %1 - spawning combined force (SQUAD_RIFLE + FIRETEAM)", baseName);
+				PrintFormat("[IPC Reinforcement] WAVE 3 (%1min) triggering at %2 - spawning combined force (SQUAD_RIFLE + FIRETEAM)", GetWaveThreshold(3) / 60, baseName);
 
 			int successfulSpawns = 0;
 
 			// Spawn SQUAD_RIFLE
-			SCR_AIGroup squadGroup = SpawnReinforcementGroup(SCR_EGroupType.SQUAD_RIFLE);
-			if (squadGroup)
-			{
-				m_aReinforcementGroups.Insert(squadGroup);
+			if (SpawnPooledReinforcementGroup(SCR_EGroupType.SQUAD_RIFLE, wave, snapshot))
 				successfulSpawns++;
-			}
 
 			// Spawn FIRETEAM
-			SCR_AIGroup fireteamGroup = SpawnReinforcementGroup(SCR_EGroupType.FIRETEAM);
-			if (fireteamGroup)
-			{
-				m_aReinforcementGroups.Insert(fireteamGroup);
+			if (SpawnPooledReinforcementGroup(SCR_EGroupType.FIRETEAM, wave, snapshot))
 				successfulSpawns++;
-			}
 
 			if (successfulSpawns > 0)
 			{
 				PrintFormat("[IPC Reinforcement] Successfully spawned %1/2 combined force groups at %2", successfulSpawns, baseName);
+				AdmitWave(wave, previousGroups, previousHelicopters);
 				BroadcastReinforcementAlert(baseName, wave);
 			}
 			else
@@ -511,7 +568,7 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 				PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn any Wave 3 groups at %1", baseName);
 			}
 
-			return;
+			return successfulSpawns > 0;
 		}
 
 		// Handle Waves 1 and 2 - Single group type
@@ -521,42 +578,32 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		else
 			groupType = SCR_EGroupType.SQUAD_RIFLE;
 
-		string waveTime;
-		if (DEBUG_MODE)
+		int groupCount = IPC_ExtendedConfig.GetInstance().m_iReinforcementGroupCount;
+
+		if (IsDebugMode())
 		{
-			if (wave == 1)
-				waveTime = "1min";
-			else
-				waveTime = "2min";
-			PrintFormat("[IPC Reinforcement DEBUG] WAVE %1 (%2) triggering at %3 - spawning %4 reinforcement groups (type: %5)",
-						wave, waveTime, baseName, REINFORCEMENT_GROUP_COUNT, typename.EnumToString(SCR_EGroupType, groupType));
+			PrintFormat("[IPC Reinforcement DEBUG] WAVE %1 (%2s) triggering at %3 - spawning %4 reinforcement groups (type: %5)",
+						wave, GetWaveThreshold(wave), baseName, groupCount, typename.EnumToString(SCR_EGroupType, groupType));
 		}
 		else
 		{
-			if (wave == 1)
-				waveTime = "5min";
-			else
-				waveTime = "10min";
-			PrintFormat("[IPC Reinforcement] WAVE %1 (%2) triggering at %3 - spawning %4 reinforcement groups (type: %5)",
-						wave, waveTime, baseName, REINFORCEMENT_GROUP_COUNT, typename.EnumToString(SCR_EGroupType, groupType));
+			PrintFormat("[IPC Reinforcement] WAVE %1 (%2min) triggering at %3 - spawning %4 reinforcement groups (type: %5)",
+						wave, GetWaveThreshold(wave) / 60, baseName, groupCount, typename.EnumToString(SCR_EGroupType, groupType));
 		}
 
 		// Spawn reinforcement groups manually
 		int successfulSpawns = 0;
-		for (int i = 0; i < REINFORCEMENT_GROUP_COUNT; i++)
+		for (int i = 0; i < groupCount; i++)
 		{
-			SCR_AIGroup reinforcementGroup = SpawnReinforcementGroup(groupType);
-			if (reinforcementGroup)
-			{
-				m_aReinforcementGroups.Insert(reinforcementGroup);
+			if (SpawnPooledReinforcementGroup(groupType, wave, snapshot))
 				successfulSpawns++;
-			}
 		}
 
 		if (successfulSpawns > 0)
 		{
 			PrintFormat("[IPC Reinforcement] Successfully spawned %1/%2 reinforcement groups at %3",
-						successfulSpawns, REINFORCEMENT_GROUP_COUNT, baseName);
+						successfulSpawns, groupCount, baseName);
+			AdmitWave(wave, previousGroups, previousHelicopters);
 
 			// Broadcast notification
 			BroadcastReinforcementAlert(baseName, wave);
@@ -565,15 +612,96 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		{
 			PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn any reinforcement groups at %1", baseName);
 		}
+
+		return successfulSpawns > 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Advance the wave ladder once a wave actually spawned (groups, helicopter or virtual approach)
+	//! Debug mode despawns the previous wave's groups only now, so a refused wave leaves them alone
+	//------------------------------------------------------------------------------------------------
+	protected void AdmitWave(int wave, int previousGroups, int previousHelicopters)
+	{
+		if (IsDebugMode())
+			DespawnPreviousWaveGroups(previousGroups, previousHelicopters);
+
+		m_DecisionState.OnWaveTriggered(wave, GetOwner().GetWorld().GetWorldTime());
+
+		// The previous wave's shared sets stay with its groups - retire them so cleanup deletes them once unused
+		// (the new groups get theirs later, from their staggered assignment tasks)
+		RetireWaveWaypoints();
+		m_Channels.MarkDirty(IPC_EBaseChannel.GROUP_CLEANUP);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get reinforcement pool cost of a whole wave
+	//------------------------------------------------------------------------------------------------
+	protected int GetWaveCost(int wave)
+	{
+		switch (wave)
+		{
+			case 1: return IPC_ExtendedConfig.GetInstance().m_iReinforcementGroupCount * IPC_ReinforcementPool.GetGroupCost(SCR_EGroupType.FIRETEAM);
+			case 2: return IPC_ExtendedConfig.GetInstance().m_iReinforcementGroupCount * IPC_ReinforcementPool.GetGroupCost(SCR_EGroupType.SQUAD_RIFLE);
+			case 3: return IPC_ReinforcementPool.GetGroupCost(SCR_EGroupType.SQUAD_RIFLE) + IPC_ReinforcementPool.GetGroupCost(SCR_EGroupType.FIRETEAM);
+			case 4: return IPC_ExtendedConfig.GetInstance().m_iPoolCostHelicopter;
+		}
+
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Spawn and track one reinforcement group that was paid from the pool
+	//! Refunds if the AI budget denies the group or the spawn fails
+	//------------------------------------------------------------------------------------------------
+	protected SCR_AIGroup SpawnPooledReinforcementGroup(SCR_EGroupType groupType, int wave, IPC_CombatSnapshot snapshot)
+	{
+		// Light kit under budget pressure: the configured light group prefab, else the regular group stripped
+		ResourceName groupPrefab = m_sPrefab;
+		bool strip = IPC_LightLoadout.ShouldUse(groupType);
+		if (strip)
+		{
+			ResourceName lightPrefab = IPC_LightLoadout.GetLightPrefab(m_Faction.GetFactionKey(), groupType);
+			if (!lightPrefab.IsEmpty())
+			{
+				groupPrefab = lightPrefab;
+				strip = false;
+			}
+		}
+
+		SCR_AIGroup group;
+		int estimatedAgents = IPC_AIBudget.EstimateAgents(IPC_ExtendedConfig.GetInstance().m_iReinforcementGroupCount, groupPrefab);
+		if (IPC_AIBudget.GetInstance().CanSpawn(IPC_EAIBudgetSubsystem.REINFORCEMENTS, estimatedAgents))
+			group = SpawnReinforcementGroup(groupType, groupPrefab, strip, snapshot);
+
+		if (!group)
+		{
+			IPC_ReinforcementPool.GetInstance().Refund(m_Faction, IPC_ReinforcementPool.GetGroupCost(groupType));
+			return null;
+		}
+
+		m_aReinforcementGroups.Insert(group);
+
+		IPC_StuckRecord stuckRecord = new IPC_StuckRecord();
+		stuckRecord.m_Group = group;
+		m_aStuckRecords.Insert(stuckRecord);
+		m_Channels.MarkDirty(IPC_EBaseChannel.GROUP_CLEANUP);
+		m_Channels.MarkDirty(IPC_EBaseChannel.WATCHDOG);
+
+		IPC_AIBudget.GetInstance().Track(group, IPC_EAIBudgetSubsystem.REINFORCEMENTS);
+		IPC_WaveMetrics.GetInstance().OnGroupSpawned(group, m_nearBase.GetOwner().GetName(), m_Faction.GetFactionKey(), wave, typename.EnumToString(SCR_EGroupType, groupType));
+		IPC_CasualtyCleanup.GetInstance().TrackGroup(group);
+		return group;
 	}
 
 	//------------------------------------------------------------------------------------------------
 	//! Manually spawn a single reinforcement group (similar to parent mod's attacking units)
+	//! The snapshot (captured with bases) provides the player clearance of source bases
+	//! \param groupPrefab m_sPrefab or its light variant; strip = apply the light kit after spawning
 	//------------------------------------------------------------------------------------------------
-	protected SCR_AIGroup SpawnReinforcementGroup(SCR_EGroupType groupType)
+	protected SCR_AIGroup SpawnReinforcementGroup(SCR_EGroupType groupType, ResourceName groupPrefab, bool strip, IPC_CombatSnapshot snapshot)
 	{
 		// Validate prerequisites
-		if (m_sPrefab.IsEmpty())
+		if (groupPrefab.IsEmpty())
 		{
 			Print("[IPC Reinforcement] ERROR: No group prefab defined", LogLevel.ERROR);
 			return null;
@@ -592,23 +720,38 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		}
 
 		// Load group prefab
-		Resource prefab = Resource.Load(m_sPrefab);
+		Resource prefab = Resource.Load(groupPrefab);
 		if (!prefab || !prefab.IsValid())
 		{
-			PrintFormat("[IPC Reinforcement] ERROR: Failed to load group prefab: %1", m_sPrefab);
+			PrintFormat("[IPC Reinforcement] ERROR: Failed to load group prefab: %1", groupPrefab);
 			return null;
 		}
 
 		// Find spawn position near the base with dispersion
-		vector basePos = m_nearBase.GetOwner().GetOrigin();
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
 		vector spawnPos;
+		array<vector> route;
+
+		// Optionally spawn at the nearest friendly base out of sight and move in along a cached road-snapped route
+		SCR_CampaignMilitaryBaseComponent sourceBase;
+		if (config.m_bSpawnAtFriendlyBase)
+			sourceBase = FindReinforcementSourceBase(snapshot);
 
-		// Use wider dispersion for reinforcements (100-300m from base)
-		array<vector> positions = {};
-		if (SCR_WorldTools.FindAllEmptyTerrainPositions(positions, basePos, REINFORCEMENT_SPAWN_RADIUS, 5, 2) > 0)
-			spawnPos = positions.GetRandomElement();
+		// Positions come from the ring cache only - no world query on the trigger path
+		bool validated;
+		if (sourceBase)
+		{
+			validated = IPC_SpawnRingCache.GetInstance().GetSourcePosition(sourceBase, spawnPos);
+			route = IPC_RouteCache.GetInstance().GetRoute(sourceBase, m_nearBase);
+		}
 		else
-			spawnPos = basePos; // Fallback to base position
+		{
+			// Use wider dispersion for reinforcements (100-300m from base)
+			validated = IPC_SpawnRingCache.GetInstance().GetSpawnPosition(m_nearBase, spawnPos);
+		}
+
+		if (!validated)
+			PrintFormat("[IPC Reinforcement] WARNING: Spawn ring cache still validating - using unvalidated position %1", spawnPos);
 
 		// Setup spawn parameters
 		EntitySpawnParams params = EntitySpawnParams();
@@ -619,67 +762,299 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		SCR_AIGroup group = SCR_AIGroup.Cast(GetGame().SpawnEntityPrefab(prefab, null, params));
 		if (!group)
 		{
-			Print("[IPC Reinforcement] ERROR: Failed to spawn group entity", LogLevel.ERROR);
-			return null;
+			Print("[IPC Reinforcement] ERROR: Failed to spawn group entity", LogLevel.ERROR);
+			return null;
+		}
+
+		// Spawn units within the group (m_iReinforcementGroupCount times)
+		if (!group.GetSpawnImmediately())
+		{
+			for (int i = 0; i < config.m_iReinforcementGroupCount; i++)
+			{
+				group.SpawnUnits();
+			}
+		}
+
+		// Configure AI agents
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+		group.PreventMaxLOD();
+
+		// Spread the units over the validated formation slots of the spawn position (no pile for the physics solver)
+		SCR_CampaignMilitaryBaseComponent spawnBase = m_nearBase;
+		if (sourceBase)
+			spawnBase = sourceBase;
+
+		array<vector> slots = {};
+		if (validated && IPC_SpawnRingCache.GetInstance().GetSpawnSlots(spawnBase, spawnPos, slots))
+			PlaceOnSlots(agents, slots);
+
+		foreach (AIAgent agent : agents)
+		{
+			agent.PreventMaxLOD();
+
+			// Get combat component for AI configuration
+			IEntity agentEntity = agent.GetControlledEntity();
+			if (!agentEntity)
+				continue;
+
+			SCR_AIInfoComponent infoComponent = SCR_AIInfoComponent.Cast(agentEntity.FindComponent(SCR_AIInfoComponent));
+			if (!infoComponent)
+				continue;
+
+			SCR_AICombatComponent combatComponent = infoComponent.GetCombatComponent();
+			if (!combatComponent)
+				continue;
+
+			// Set AI skill based on player count (same as parent mod)
+			ApplyReinforcementSkill(combatComponent);
+		}
+
+		// Perception is lowered while the group idles in a dense cluster far from players
+		RegisterPerceptionScaling(group);
+
+		// Light kit while the AI or entity budget is under pressure (light prefab spawned, or strip now)
+		if (strip)
+			IPC_LightLoadout.ApplyToGroup(group);
+		else if (groupPrefab != m_sPrefab)
+			IPC_LightLoadout.CountLightPrefabGroup();
+
+		// Defend waypoint at the base (after the road-snapped route when spawned at a source base), staggered per group
+		QueueDefendWaypoint(group, sourceBase, route);
+
+		if (sourceBase)
+			PrintFormat("[IPC Reinforcement] Spawned reinforcement group with %1 agents (type: %2) at source base %3 (%4 route points)",
+						agents.Count(), typename.EnumToString(SCR_EGroupType, groupType), sourceBase.GetOwner().GetName(), route.Count());
+		else
+			PrintFormat("[IPC Reinforcement] Spawned reinforcement group with %1 agents (type: %2)",
+						agents.Count(), typename.EnumToString(SCR_EGroupType, groupType));
+
+		return group;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Move freshly spawned units onto separate slots (same frame, before physics resolves the overlap)
+	//! Teleport moves the character's physics and controller along, not only the entity transform.
+	//! Units beyond the slot count stay where the group spawned them
+	//------------------------------------------------------------------------------------------------
+	protected void PlaceOnSlots(notnull array<AIAgent> agents, notnull array<vector> slots)
+	{
+		int count = Math.Min(agents.Count(), slots.Count());
+		for (int i = 0; i < count; i++)
+		{
+			IEntity agentEntity = agents[i].GetControlledEntity();
+			if (!agentEntity)
+				continue;
+
+			vector transform[4];
+			agentEntity.GetWorldTransform(transform);
+			transform[3] = slots[i];
+
+			BaseGameEntity gameEntity = BaseGameEntity.Cast(agentEntity);
+			if (gameEntity)
+			{
+				gameEntity.Teleport(transform);
+			}
+			else
+			{
+				agentEntity.SetWorldTransform(transform);
+				agentEntity.Update();
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Find nearest base held by our faction that can send reinforcements unseen
+	//! (outside the AO, within max distance, with no player nearby and a warmed route)
+	//------------------------------------------------------------------------------------------------
+	protected SCR_CampaignMilitaryBaseComponent FindReinforcementSourceBase(IPC_CombatSnapshot snapshot)
+	{
+		SCR_GameModeCampaign gameMode = SCR_GameModeCampaign.GetInstance();
+		if (!gameMode || !m_Faction)
+			return null;
+
+		SCR_CampaignMilitaryBaseManager baseManager = gameMode.GetBaseManager();
+		if (!baseManager)
+			return null;
+
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		vector basePos = m_nearBase.GetOwner().GetOrigin();
+
+		array<SCR_CampaignMilitaryBaseComponent> friendlyBases = {};
+		baseManager.GetBases(friendlyBases, m_Faction);
+
+		SCR_CampaignMilitaryBaseComponent bestBase;
+		float bestDistance = config.m_fSourceBaseMaxDistance;
+
+		foreach (SCR_CampaignMilitaryBaseComponent friendlyBase : friendlyBases)
+		{
+			if (friendlyBase == m_nearBase)
+				continue;
+
+			vector friendlyPos = friendlyBase.GetOwner().GetOrigin();
+			float distance = vector.Distance(basePos, friendlyPos);
+			if (distance < config.m_fSourceBaseMinDistance || distance > bestDistance)
+				continue;
+
+			// Routes are only looked up here - a pair that is not warmed yet cannot be a source
+			if (!IPC_RouteCache.GetInstance().GetRoute(friendlyBase, m_nearBase))
+				continue;
+
+			// Nearest player of every base from the director tick's proximity sweep
+			IPC_BaseProximity proximity = snapshot.GetBaseProximity(snapshot.FindBaseIndex(friendlyBase));
+			if (proximity && proximity.m_fNearestPlayerDistance >= 0 && proximity.m_fNearestPlayerDistance < config.m_fSourceBasePlayerClearance)
+				continue;	// Watched by a player
+
+			bestBase = friendlyBase;
+			bestDistance = distance;
+		}
+
+		return bestBase;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Set reinforcement AI skill and perception based on player count (same tiers as parent mod)
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyReinforcementSkill(SCR_AICombatComponent combatComponent)
+	{
+		EAISkill skill;
+		float perception;
+		GetReinforcementSkill(skill, perception);
+
+		combatComponent.SetAISkill(skill);
+		combatComponent.SetPerceptionFactor(perception);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Reinforcement skill and perception for the current player count
+	//------------------------------------------------------------------------------------------------
+	protected void GetReinforcementSkill(out EAISkill skill, out float perception)
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		int players = GetGame().GetPlayerManager().GetPlayerCount();
+
+		if (players < config.m_iHighPopPlayerCount)
+		{
+			skill = EAISkill.EXPERT;
+			perception = config.m_fReinforcementPerception;
+		}
+		else
+		{
+			skill = EAISkill.CYLON;
+			perception = config.m_fHighPopPerception;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Hand a spawned group to IPC_PerceptionScaler with its spawn skill and perception
+	//------------------------------------------------------------------------------------------------
+	protected void RegisterPerceptionScaling(SCR_AIGroup group)
+	{
+		EAISkill skill;
+		float perception;
+		GetReinforcementSkill(skill, perception);
+		IPC_PerceptionScaler.GetInstance().Register(group, skill, perception);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Spawn the helicopter of a virtual approach at its current position (called by IPC_VirtualHelicopter)
+	//! The AI budget is checked again - it may have filled up during the approach; if dropped, cost goes back to faction's pool
+	//------------------------------------------------------------------------------------------------
+	void MaterializeHelicopter(vector position, Faction faction, int cost)
+	{
+		int startTick = IPC_ScriptTimer.Start();
+
+		bool spawned;
+		if (m_nearBase && IPC_AIBudget.GetInstance().CanSpawn(IPC_EAIBudgetSubsystem.HELICOPTER_CREW, IPC_ExtendedConfig.GetInstance().m_iHelicopterCrewSize))
+			spawned = SpawnHelicopterWave(position);
+
+		if (!spawned)
+			IPC_ReinforcementPool.GetInstance().Refund(faction, cost);
+
+		IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.SPAWNING, startTick);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Spawn the wave 4 armed helicopter with its default crew at a position
+	//! \return false if the helicopter could not be spawned (caller refunds the wave)
+	//------------------------------------------------------------------------------------------------
+	protected bool SpawnHelicopterWave(vector spawnPos)
+	{
+		string baseName = m_nearBase.GetOwner().GetName();
+
+		// Spawn armed helicopter (Mi-8MT) - TESTING: Just helicopter, no ground team
+		IEntity helicopter = SpawnArmedHelicopter(spawnPos);
+		if (!helicopter)
+		{
+			PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn helicopter");
+			PrintFormat("[IPC Reinforcement] ERROR: Failed to spawn any Wave 4 reinforcements at %1", baseName);
+			return false;
 		}
 
-		// Spawn units within the group (REINFORCEMENT_GROUP_COUNT times)
-		if (!group.GetSpawnImmediately())
+		PrintFormat("[IPC Reinforcement] Helicopter spawned, checking for compartment manager...");
+
+		// Try to get the vehicle's compartment manager
+		SCR_BaseCompartmentManagerComponent compartmentMgr = SCR_BaseCompartmentManagerComponent.Cast(
+			helicopter.FindComponent(SCR_BaseCompartmentManagerComponent));
+
+		if (compartmentMgr)
 		{
-			for (int i = 0; i < REINFORCEMENT_GROUP_COUNT; i++)
+			PrintFormat("[IPC Reinforcement] Found compartment manager, attempting to spawn default occupants...");
+
+			// Try to spawn default crew defined in the vehicle prefab
+			if (compartmentMgr.SpawnDefaultOccupants(ECompartmentType.PILOT | ECompartmentType.TURRET))
+				PrintFormat("[IPC Reinforcement] Wave 4 helicopter spawned with default crew");
+			else
+				PrintFormat("[IPC Reinforcement] WARNING: SpawnDefaultOccupants returned false");
+
+			// The crew counts against the helicopter share of the AI budget and is wave 4's group for the wave metrics
+			SCR_AIGroup crewGroup = GetCrewGroup(helicopter);
+			if (crewGroup)
 			{
-				group.SpawnUnits();
+				IPC_AIBudget.GetInstance().Track(crewGroup, IPC_EAIBudgetSubsystem.HELICOPTER_CREW);
+				IPC_WaveMetrics.GetInstance().OnGroupSpawned(crewGroup, baseName, m_Faction.GetFactionKey(), 4, "HELICOPTER_CREW");
 			}
 		}
+		else
+		{
+			PrintFormat("[IPC Reinforcement] WARNING: Helicopter has no compartment manager");
+		}
 
-		// Configure AI agents
-		array<AIAgent> agents = {};
-		group.GetAgents(agents);
-		group.PreventMaxLOD();
+		IPC_CasualtyCleanup.GetInstance().TrackVehicle(helicopter);
 
-		foreach (AIAgent agent : agents)
-		{
-			agent.PreventMaxLOD();
+		// Helicopter counts as spawned even without crew
+		PrintFormat("[IPC Reinforcement] Successfully spawned Wave 4 reinforcements (1 elements) at %1", baseName);
+		BroadcastReinforcementAlert(baseName, 4);
+		return true;
+	}
 
-			// Get combat component for AI configuration
-			IEntity agentEntity = agent.GetControlledEntity();
-			if (!agentEntity)
-				continue;
+	//------------------------------------------------------------------------------------------------
+	//! AI group of the default occupants of a helicopter (null without an AI occupant)
+	//------------------------------------------------------------------------------------------------
+	protected SCR_AIGroup GetCrewGroup(IEntity helicopter)
+	{
+		if (!helicopter)
+			return null;
 
-			SCR_AIInfoComponent infoComponent = SCR_AIInfoComponent.Cast(agentEntity.FindComponent(SCR_AIInfoComponent));
-			if (!infoComponent)
-				continue;
+		BaseCompartmentManagerComponent compartmentMgr = BaseCompartmentManagerComponent.Cast(helicopter.FindComponent(BaseCompartmentManagerComponent));
+		if (!compartmentMgr)
+			return null;
 
-			SCR_AICombatComponent combatComponent = infoComponent.GetCombatComponent();
-			if (!combatComponent)
+		array<IEntity> occupants = {};
+		compartmentMgr.GetOccupants(occupants);
+
+		foreach (IEntity occupant : occupants)
+		{
+			AIControlComponent control = AIControlComponent.Cast(occupant.FindComponent(AIControlComponent));
+			if (!control || !control.GetAIAgent())
 				continue;
 
-			// Set AI skill based on player count (same as parent mod)
-			int players = GetGame().GetPlayerManager().GetPlayerCount();
-			if (players < 5)
-			{
-				combatComponent.SetAISkill(EAISkill.EXPERT);
-				combatComponent.SetPerceptionFactor(1.5);
-			}
-			else if (players < 10)
-			{
-				combatComponent.SetAISkill(EAISkill.EXPERT);
-				combatComponent.SetPerceptionFactor(1.5);
-			}
-			else
-			{
-				combatComponent.SetAISkill(EAISkill.CYLON);
-				combatComponent.SetPerceptionFactor(2.0);
-			}
+			SCR_AIGroup group = SCR_AIGroup.Cast(control.GetAIAgent().GetParentGroup());
+			if (group)
+				return group;
 		}
 
-		// Create defend waypoint at base position
-		CreateDefendWaypoint(group, basePos);
-
-		PrintFormat("[IPC Reinforcement] Spawned reinforcement group with %1 agents (type: %2)",
-					agents.Count(), typename.EnumToString(SCR_EGroupType, groupType));
-
-		return group;
+		return null;
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -687,8 +1062,8 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	//------------------------------------------------------------------------------------------------
 	protected vector FindHelicopterSpawnPosition(vector basePos, float distance, float altitude)
 	{
-		// Calculate random position at distance from base
-		float randomAngle = Math.RandomFloat(0, 360);
+		// Calculate random position at distance from base (deterministic per-base stream)
+		float randomAngle = IPC_ExtendedRandom.GetBaseStream(m_nearBase).RandFloatXY(0, 360);
 		float angleRad = randomAngle * Math.DEG2RAD;
 
 		vector targetPos;
@@ -696,24 +1071,16 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		targetPos[2] = basePos[2] + (Math.Sin(angleRad) * distance);
 		targetPos[1] = GetGame().GetWorld().GetSurfaceY(targetPos[0], targetPos[2]);
 
-		// Find empty terrain position for safe spawning (like parent mod does for vehicles)
-		vector spawnPos;
-		if (!SCR_WorldTools.FindEmptyTerrainPosition(spawnPos, targetPos, 100, 5, 2))
-		{
-			// Fallback to target position if no empty position found
-			spawnPos = targetPos;
-		}
-
-		// Add altitude offset (0 for ground spawn)
-		spawnPos[1] = spawnPos[1] + altitude;
+		// Spawned in the air - no empty terrain search needed (keeps world queries off the trigger path)
+		targetPos[1] = targetPos[1] + altitude;
 
-		return spawnPos;
+		return targetPos;
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Spawn armed helicopter (Mi-8MT) at distance from base
+	//! Spawn armed helicopter (Mi-8MT) at a position, facing the base
 	//------------------------------------------------------------------------------------------------
-	protected IEntity SpawnArmedHelicopter()
+	protected IEntity SpawnArmedHelicopter(vector spawnPos)
 	{
 		if (!m_nearBase)
 		{
@@ -729,9 +1096,7 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 			return null;
 		}
 
-		// Find spawn position far from base (spawned at altitude, already flying)
 		vector basePos = m_nearBase.GetOwner().GetOrigin();
-		vector spawnPos = FindHelicopterSpawnPosition(basePos, HELICOPTER_SPAWN_DISTANCE, HELICOPTER_SPAWN_ALTITUDE);
 
 		// Setup spawn parameters
 		EntitySpawnParams params = EntitySpawnParams();
@@ -753,7 +1118,7 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		}
 
 		PrintFormat("[IPC Reinforcement] Spawned helicopter at position %1 (distance: %2m from base, altitude: %3m)",
-					spawnPos, vector.Distance(spawnPos, basePos), HELICOPTER_SPAWN_ALTITUDE);
+					spawnPos, vector.DistanceXZ(spawnPos, basePos), spawnPos[1] - GetGame().GetWorld().GetSurfaceY(spawnPos[0], spawnPos[2]));
 
 		// Track helicopter for cleanup
 		m_aReinforcementHelicopters.Insert(helicopter);
@@ -791,13 +1156,6 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 		vector crewSpawnPos = helicopterPos;
 		crewSpawnPos[1] = GetGame().GetWorld().GetSurfaceY(helicopterPos[0], helicopterPos[2]); // Ground level
 
-		// Find empty position on ground
-		vector emptyPos;
-		if (SCR_WorldTools.FindEmptyTerrainPosition(emptyPos, crewSpawnPos, 50, 5, 2))
-		{
-			crewSpawnPos = emptyPos;
-		}
-
 		// Setup spawn parameters
 		EntitySpawnParams params = EntitySpawnParams();
 		params.TransformMode = ETransformMode.WORLD;
@@ -844,25 +1202,11 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 				continue;
 
 			// Set AI skill based on player count (same as infantry)
-			int players = GetGame().GetPlayerManager().GetPlayerCount();
-			if (players < 5)
-			{
-				combatComponent.SetAISkill(EAISkill.EXPERT);
-				combatComponent.SetPerceptionFactor(1.5);
-			}
-			else if (players < 10)
-			{
-				combatComponent.SetAISkill(EAISkill.EXPERT);
-				combatComponent.SetPerceptionFactor(1.5);
-			}
-			else
-			{
-				combatComponent.SetAISkill(EAISkill.CYLON);
-				combatComponent.SetPerceptionFactor(2.0);
-			}
+			ApplyReinforcementSkill(combatComponent);
 		}
 
 		PrintFormat("[IPC Reinforcement] Spawned helicopter crew with %1 agents (will be moved into compartments)", agents.Count());
+		RegisterPerceptionScaling(group);
 
 		return group;
 	}
@@ -931,53 +1275,189 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Create a defend waypoint for a reinforcement group
+	//! Queue the waypoint assignment of a new group on the task runner, m_iWaypointStaggerMs after the
+	//! previous group of this spawn point, so a multi-group wave does not request all paths in one frame
 	//------------------------------------------------------------------------------------------------
-	protected void CreateDefendWaypoint(SCR_AIGroup group, vector targetPos)
+	protected void QueueDefendWaypoint(SCR_AIGroup group, SCR_CampaignMilitaryBaseComponent sourceBase, array<vector> route)
 	{
-		if (!group)
+		float now = GetOwner().GetWorld().GetWorldTime();
+		float slot = Math.Max(now, m_fNextWaypointSlot);
+		m_fNextWaypointSlot = slot + IPC_ExtendedConfig.GetInstance().m_iWaypointStaggerMs;
+
+		IPC_TaskRunner.GetInstance().Add(new IPC_WaypointAssignmentTask(this, group, sourceBase, route, slot - now));
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Assign the defend waypoint (IPC_WaypointAssignmentTask, stuck watchdog with resume)
+	//! Groups of one wave with the same approach share one waypoint set: the optional route positions
+	//! as move waypoints, then one defend waypoint near the base. Resuming re-issues the set from the
+	//! group's current waypoint so a stuck group is not sent back along the route.
+	//------------------------------------------------------------------------------------------------
+	void CreateDefendWaypoint(SCR_AIGroup group, SCR_CampaignMilitaryBaseComponent sourceBase = null, array<vector> route = null, bool resume = false)
+	{
+		if (!group || !m_nearBase)
 			return;
 
+		// Remember the approach so the watchdog can re-issue it
+		foreach (IPC_StuckRecord record : m_aStuckRecords)
+		{
+			if (record.m_Group == group)
+			{
+				record.m_SourceBase = sourceBase;
+				record.m_aRoute = route;
+				break;
+			}
+		}
+
+		string approachKey;
+		if (sourceBase)
+			approachKey = string.Format("%1", sourceBase.GetOwner().GetID());
+
+		array<AIWaypoint> waypoints = m_mWaveWaypoints.Get(approachKey);
+		if (!waypoints || waypoints.IsEmpty() || !waypoints[waypoints.Count() - 1])
+		{
+			waypoints = {};
+			if (!SpawnWaveWaypoints(waypoints, route))
+				return;
+
+			m_mWaveWaypoints.Set(approachKey, waypoints);
+		}
+
+		int firstIndex;
+		if (resume)
+			firstIndex = Math.Max(waypoints.Find(group.GetCurrentWaypoint()), 0);
+
+		// Clear any existing waypoints
+		array<AIWaypoint> existingWaypoints = {};
+		group.GetWaypoints(existingWaypoints);
+		foreach (AIWaypoint wp : existingWaypoints)
+		{
+			group.RemoveWaypoint(wp);
+		}
+
+		for (int i = firstIndex; i < waypoints.Count(); i++)
+		{
+			if (waypoints[i])
+				group.AddWaypoint(waypoints[i]);
+		}
+
+		PrintFormat("[IPC Reinforcement] Assigned defend waypoint for reinforcement group at %1", m_nearBase.GetOwner().GetName());
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Spawn the waypoint set of one wave approach (route move waypoints, then the defend waypoint)
+	//------------------------------------------------------------------------------------------------
+	protected bool SpawnWaveWaypoints(notnull array<AIWaypoint> waypoints, array<vector> route)
+	{
 		// Get waypoint prefab from component class data
 		IPC_DefenderSpawnPointComponentClass componentData = IPC_DefenderSpawnPointComponentClass.Cast(GetComponentData(GetOwner()));
 		if (!componentData)
 		{
 			Print("[IPC Reinforcement] WARNING: No component data for waypoint", LogLevel.WARNING);
-			return;
+			return false;
 		}
 
 		Resource waypointResource = Resource.Load(componentData.GetDefaultWaypointPrefab());
 		if (!waypointResource || !waypointResource.IsValid())
 		{
 			Print("[IPC Reinforcement] WARNING: Invalid waypoint prefab", LogLevel.WARNING);
-			return;
+			return false;
 		}
 
-		// Find position near base for waypoint
+		// Find position near base for waypoint (validated ring cache, unvalidated candidate while validating)
 		vector waypointPos;
-		SCR_WorldTools.FindEmptyTerrainPosition(waypointPos, targetPos, 30, 2, 2);
+		IPC_SpawnRingCache.GetInstance().GetWaypointPosition(m_nearBase, waypointPos);
 
 		// Setup waypoint spawn parameters
 		EntitySpawnParams params = EntitySpawnParams();
 		params.TransformMode = ETransformMode.WORLD;
 		params.Transform[3] = waypointPos;
 
-		// Spawn and assign waypoint
-		AIWaypoint waypoint = AIWaypoint.Cast(GetGame().SpawnEntityPrefab(waypointResource, null, params));
-		if (waypoint)
+		AIWaypoint defendWaypoint = AIWaypoint.Cast(GetGame().SpawnEntityPrefab(waypointResource, null, params));
+		if (!defendWaypoint)
+			return false;
+
+		// Follow the road-snapped route first (spawned at a source base)
+		if (route)
+			AddRouteWaypoints(waypoints, route);
+
+		waypoints.Insert(defendWaypoint);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Add a move waypoint for every route position
+	//------------------------------------------------------------------------------------------------
+	protected void AddRouteWaypoints(notnull array<AIWaypoint> waypoints, notnull array<vector> route)
+	{
+		if (route.IsEmpty())
+			return;
+
+		Resource moveResource = Resource.Load(IPC_ExtendedConfig.GetInstance().m_sMoveWaypointPrefab);
+		if (!moveResource || !moveResource.IsValid())
+		{
+			Print("[IPC Reinforcement] WARNING: Invalid move waypoint prefab - group will move directly to base", LogLevel.WARNING);
+			return;
+		}
+
+		EntitySpawnParams params = EntitySpawnParams();
+		params.TransformMode = ETransformMode.WORLD;
+
+		foreach (vector routePos : route)
+		{
+			params.Transform[3] = routePos;
+			AIWaypoint moveWaypoint = AIWaypoint.Cast(GetGame().SpawnEntityPrefab(moveResource, null, params));
+			if (moveWaypoint)
+				waypoints.Insert(moveWaypoint);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Stop handing out the waypoint sets of the current wave (deleted by DeleteUnusedWaypoints)
+	//------------------------------------------------------------------------------------------------
+	protected void RetireWaveWaypoints()
+	{
+		foreach (string approachKey, array<AIWaypoint> waypoints : m_mWaveWaypoints)
 		{
-			// Clear any existing waypoints
-			array<AIWaypoint> existingWaypoints = {};
-			group.GetWaypoints(existingWaypoints);
-			foreach (AIWaypoint wp : existingWaypoints)
+			foreach (AIWaypoint waypoint : waypoints)
 			{
-				group.RemoveWaypoint(wp);
+				if (waypoint)
+					m_aRetiredWaypoints.Insert(waypoint);
 			}
+		}
 
-			// Add defend waypoint
-			group.AddWaypoint(waypoint);
-			PrintFormat("[IPC Reinforcement] Created defend waypoint for reinforcement group at %1",
-						m_nearBase.GetOwner().GetName());
+		m_mWaveWaypoints.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Delete retired move and defend waypoints that no tracked reinforcement group still follows
+	//------------------------------------------------------------------------------------------------
+	protected void DeleteUnusedWaypoints()
+	{
+		if (m_aRetiredWaypoints.IsEmpty())
+			return;
+
+		array<AIWaypoint> usedWaypoints = {};
+		array<AIWaypoint> groupWaypoints = {};
+		foreach (SCR_AIGroup group : m_aReinforcementGroups)
+		{
+			if (!group)
+				continue;
+
+			groupWaypoints.Clear();
+			group.GetWaypoints(groupWaypoints);
+			usedWaypoints.InsertAll(groupWaypoints);
+		}
+
+		for (int i = m_aRetiredWaypoints.Count() - 1; i >= 0; i--)
+		{
+			AIWaypoint waypoint = m_aRetiredWaypoints[i];
+			if (waypoint && usedWaypoints.Contains(waypoint))
+				continue;
+
+			m_aRetiredWaypoints.Remove(i);
+			if (waypoint && !waypoint.IsDeleted())
+				RplComponent.DeleteRplEntity(waypoint, false);
 		}
 	}
 
@@ -986,14 +1466,14 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	//------------------------------------------------------------------------------------------------
 	protected void BroadcastReinforcementAlert(string baseName, int wave)
 	{
-		// Schedule notification slightly delayed to avoid RPC timing issues
-		GetGame().GetCallqueue().CallLater(DoSendReinforcementAlert, 100, false, baseName, wave);
+		// Notification is slightly delayed on the task runner to avoid RPC timing issues
+		IPC_TaskRunner.GetInstance().Add(new IPC_ReinforcementAlertTask(this, baseName, wave));
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Actually send the reinforcement alert (called after short delay)
+	//! Actually send the reinforcement alert (IPC_ReinforcementAlertTask, after a short delay)
 	//------------------------------------------------------------------------------------------------
-	protected void DoSendReinforcementAlert(string baseName, int wave)
+	void DoSendReinforcementAlert(string baseName, int wave)
 	{
 		// Use SCR_PopUpNotification directly instead of RPC system
 		// This avoids "RpcError: Calling a RPC from an unregistered item" error
@@ -1014,13 +1494,134 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Cleanup dead reinforcement groups (called periodically)
+	//! Per-base update channels of this spawn point
 	//------------------------------------------------------------------------------------------------
-	protected void CleanupDeadReinforcementGroups()
+	IPC_BaseChannels GetBaseChannels()
 	{
-		if (m_aReinforcementGroups.IsEmpty())
+		return m_Channels;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Run the scheduler-driven channels that are due and dirty (IPC_BaseChannelScheduler, every second)
+	//------------------------------------------------------------------------------------------------
+	void RunBaseChannels(float now)
+	{
+		if (!m_nearBase)
 			return;
 
+		if (m_Channels.Consume(IPC_EBaseChannel.GROUP_CLEANUP, now))
+		{
+			int cleanupStart = IPC_ScriptTimer.Start();
+			CleanupDeadReinforcementGroups();
+			IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.CLEANUP, cleanupStart);
+
+			// Remaining groups can still die or drop waypoints - nothing left means nothing to clean up
+			if (!m_aReinforcementGroups.IsEmpty() || !m_aRetiredWaypoints.IsEmpty())
+				m_Channels.MarkDirty(IPC_EBaseChannel.GROUP_CLEANUP);
+		}
+
+		if (m_Channels.Consume(IPC_EBaseChannel.FRONTLINE, now))
+		{
+			// Snapshot capture is shared by the whole tick - only the decision is booked on the base
+			IPC_CombatSnapshot snapshot = IPC_BaseChannelScheduler.GetInstance().GetSnapshot();
+			int frontlineStart = IPC_ScriptTimer.Start();
+			UpdateFrontline(snapshot);
+			IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.DETECTION, frontlineStart);
+		}
+
+		if (m_Channels.Consume(IPC_EBaseChannel.WATCHDOG, now))
+		{
+			int watchdogStart = IPC_ScriptTimer.Start();
+			RunStuckWatchdog();
+			IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.WAYPOINTS, watchdogStart);
+
+			if (!m_aStuckRecords.IsEmpty())
+				m_Channels.MarkDirty(IPC_EBaseChannel.WATCHDOG);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Re-route reinforcement groups out of combat that barely moved since the last check while still away from the base
+	//------------------------------------------------------------------------------------------------
+	protected void RunStuckWatchdog()
+	{
+		IPC_ExtendedConfig config = IPC_ExtendedConfig.GetInstance();
+		vector basePos = m_nearBase.GetOwner().GetOrigin();
+		float arrivedSq = config.m_fCombatDetectionRange * config.m_fCombatDetectionRange;
+		float stuckSq = config.m_fStuckDistance * config.m_fStuckDistance;
+
+		for (int i = m_aStuckRecords.Count() - 1; i >= 0; i--)
+		{
+			IPC_StuckRecord record = m_aStuckRecords[i];
+			if (!record.m_Group || record.m_Group.GetAgentsCount() == 0)
+			{
+				m_aStuckRecords.Remove(i);
+				continue;
+			}
+
+			// Holding position in a fight is not being stuck - start over once the fight is over
+			if (IsGroupInCombat(record.m_Group))
+			{
+				record.m_bHasPosition = false;
+				continue;
+			}
+
+			vector groupPos = record.m_Group.GetOrigin();
+			IEntity leader = record.m_Group.GetLeaderEntity();
+			if (leader)
+				groupPos = leader.GetOrigin();
+
+			// Arrived (or fighting at the base) - movement no longer matters
+			bool away = vector.DistanceSqXZ(groupPos, basePos) > arrivedSq;
+
+			if (away && record.m_bHasPosition && vector.DistanceSqXZ(groupPos, record.m_vLastPosition) < stuckSq)
+			{
+				PrintFormat("[IPC Reinforcement] Reinforcement group stuck at %1 (%2m from %3) - re-routing",
+							groupPos, Math.Round(vector.DistanceXZ(groupPos, basePos)), m_nearBase.GetOwner().GetName());
+				CreateDefendWaypoint(record.m_Group, record.m_SourceBase, record.m_aRoute, true);
+				IPC_BaseChannelScheduler.GetInstance().CountStuckRecovery();
+			}
+
+			record.m_vLastPosition = groupPos;
+			record.m_bHasPosition = true;
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Does any member of the group see a target or feel threatened (danger events, suppression)
+	//------------------------------------------------------------------------------------------------
+	protected bool IsGroupInCombat(SCR_AIGroup group)
+	{
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+
+		foreach (AIAgent agent : agents)
+		{
+			IEntity agentEntity = agent.GetControlledEntity();
+			if (!agentEntity)
+				continue;
+
+			SCR_AIInfoComponent infoComponent = SCR_AIInfoComponent.Cast(agentEntity.FindComponent(SCR_AIInfoComponent));
+			if (!infoComponent)
+				continue;
+
+			EAIThreatState threatState = infoComponent.GetThreatState();
+			if (threatState == EAIThreatState.ALERTED || threatState == EAIThreatState.THREATENED)
+				return true;
+
+			SCR_AICombatComponent combatComponent = infoComponent.GetCombatComponent();
+			if (combatComponent && combatComponent.GetCurrentTarget())
+				return true;
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Cleanup dead reinforcement groups and the waypoints they no longer follow (called periodically)
+	//------------------------------------------------------------------------------------------------
+	protected void CleanupDeadReinforcementGroups()
+	{
 		// Check each reinforcement group
 		for (int i = m_aReinforcementGroups.Count() - 1; i >= 0; i--)
 		{
@@ -1037,6 +1638,12 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 				m_aReinforcementGroups.Remove(i);
 			}
 		}
+
+		// Every group of the wave is gone - its waypoints are not needed anymore
+		if (m_aReinforcementGroups.IsEmpty())
+			RetireWaveWaypoints();
+
+		DeleteUnusedWaypoints();
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -1044,11 +1651,19 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	//------------------------------------------------------------------------------------------------
 	protected void ResetReinforcementState()
 	{
-		m_bReinforcementActive = false;
-		m_iReinforcementWave = 0;
+		m_DecisionState.ResetCombat();
+		m_iDeferredWave = 0;
+
+		// Waypoints of the ended combat are deleted as soon as their groups are gone or done with them
+		RetireWaveWaypoints();
+		m_Channels.MarkDirty(IPC_EBaseChannel.GROUP_CLEANUP);
+
+		// Close wave metrics of this base (agents still alive count as survivors)
+		if (m_nearBase)
+			IPC_WaveMetrics.GetInstance().OnBaseReset(m_nearBase.GetOwner().GetName());
 
 		// In debug mode, immediately despawn all reinforcements when combat ends
-		if (DEBUG_MODE)
+		if (IsDebugMode())
 		{
 			DespawnPreviousWaveGroups();
 		}
@@ -1060,133 +1675,90 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	//------------------------------------------------------------------------------------------------
 	//! Check if this base should keep defenders active (frontline detection)
 	//------------------------------------------------------------------------------------------------
-	protected bool ShouldKeepDefendersActive()
+	protected bool ShouldKeepDefendersActive(IPC_CombatSnapshot snapshot)
 	{
 		if (!m_nearBase)
 			return false;
 
 		// RULE 1: Only apply to friendly bases
-		if (!IsBaseFriendly(m_nearBase))
+		if (!IsBaseFriendly(snapshot, m_nearBase))
 			return true; // Keep enemy defenders always active
 
-		// RULE 2: Check if base is on frontline (enemy base nearby)
-		if (IsBaseOnFrontline(m_nearBase))
-		{
-			m_tInactiveSince = null; // Reset grace period
-			return true; // Frontline base - keep active
-		}
-
+		// RULE 2: Check if base is on frontline (enemy base nearby) - resets the grace period
 		// Base is not on frontline - apply grace period before despawning
 		// The 10-minute grace period handles temporary combat situations
-		ChimeraWorld world = GetOwner().GetWorld();
-		if (!world)
-			return true;
-
-		WorldTimestamp currentTime = world.GetServerTimestamp();
+		bool graceStarted;
+		bool keepActive = m_DecisionState.UpdateGracePeriod(IsBaseOnFrontline(snapshot, m_nearBase), snapshot.m_fTime, graceStarted);
 
-		// Start grace period if not already started
-		if (!m_tInactiveSince)
+		if (graceStarted)
 		{
-			m_tInactiveSince = currentTime;
-			PrintFormat("[IPC Defender] Base %1 became inactive - grace period started (10min)",
-						m_nearBase.GetOwner().GetName());
+			PrintFormat("[IPC Defender] Base %1 became inactive - grace period started (%2s)",
+						m_nearBase.GetOwner().GetName(), IPC_ExtendedConfig.GetInstance().m_iInactiveGracePeriod);
 			return true; // Keep active during grace period
 		}
 
-		// Check if grace period expired
-		float inactiveDuration = currentTime.DiffMilliseconds(m_tInactiveSince) / 1000.0;
-		if (inactiveDuration >= INACTIVE_GRACE_PERIOD)
+		float inactiveDuration = m_DecisionState.GetInactiveDuration(snapshot.m_fTime);
+
+		// Grace period expired - despawn
+		if (!keepActive)
 		{
 			PrintFormat("[IPC Defender] Base %1 inactive for %2s - despawning defenders",
 						m_nearBase.GetOwner().GetName(), inactiveDuration);
-			return false; // Grace period expired - despawn
+			return false;
 		}
 
 		// Still in grace period
-		if (DEBUG_MODE)
+		if (IsDebugMode() && inactiveDuration > 0)
 		{
-			float timeRemaining = INACTIVE_GRACE_PERIOD - inactiveDuration;
+			float timeRemaining = IPC_ExtendedConfig.GetInstance().m_iInactiveGracePeriod - inactiveDuration;
 			PrintFormat("[IPC Defender DEBUG] Base %1 inactive - %2s until despawn",
 						m_nearBase.GetOwner().GetName(), timeRemaining);
 		}
 
-		return true; // Keep active during grace period
+		return true; // Keep active (frontline or grace period)
 	}
 
 	//------------------------------------------------------------------------------------------------
 	//! Check if base is controlled by a friendly faction (player's faction)
 	//------------------------------------------------------------------------------------------------
-	protected bool IsBaseFriendly(SCR_CampaignMilitaryBaseComponent base)
+	protected bool IsBaseFriendly(IPC_CombatSnapshot snapshot, SCR_CampaignMilitaryBaseComponent base)
 	{
 		Faction baseFaction = base.GetFaction();
 		if (!baseFaction)
 			return false;
 
 		// Check if any player is on this base's faction
-		PlayerManager playerManager = GetGame().GetPlayerManager();
-		if (!playerManager)
-			return false;
-
-		array<int> playerIds = {};
-		playerManager.GetPlayers(playerIds);
-
-		foreach (int playerId : playerIds)
-		{
-			IEntity player = playerManager.GetPlayerControlledEntity(playerId);
-			if (!player)
-				continue;
-
-			SCR_ChimeraCharacter character = SCR_ChimeraCharacter.Cast(player);
-			if (!character)
-				continue;
-
-			Faction playerFaction = character.GetFaction();
-			if (playerFaction == baseFaction)
-				return true; // Base is friendly to at least one player
-		}
-
-		return false; // No players on this faction
+		return snapshot.HasPlayerOfFaction(baseFaction.GetFactionKey());
 	}
 
 	//------------------------------------------------------------------------------------------------
-	//! Check if base is on frontline (enemy base within attack range)
+	//! Check if base is on frontline (base of any hostile faction within attack range)
 	//------------------------------------------------------------------------------------------------
-	protected bool IsBaseOnFrontline(SCR_CampaignMilitaryBaseComponent base)
+	protected bool IsBaseOnFrontline(IPC_CombatSnapshot snapshot, SCR_CampaignMilitaryBaseComponent base)
 	{
-		SCR_GameModeCampaign gameMode = SCR_GameModeCampaign.GetInstance();
-		if (!gameMode)
-			return true;
-
-		SCR_CampaignMilitaryBaseManager baseManager = gameMode.GetBaseManager();
-		if (!baseManager)
-			return true;
-
-		SCR_CampaignFactionManager factionManager = SCR_CampaignFactionManager.Cast(GetGame().GetFactionManager());
-		if (!factionManager)
-			return true;
+		array<string> hostileFactionKeys = {};
+		GetHostileFactionKeys(hostileFactionKeys);
 
-		// Get enemy faction
-		SCR_CampaignFaction ourFaction = SCR_CampaignFaction.Cast(m_Faction);
-		if (!ourFaction)
-			return true;
+		return IPC_BaseDecisionState.IsOnFrontline(IPC_FrontlineMap.GetInstance(), snapshot, snapshot.FindBaseIndex(base), hostileFactionKeys);
+	}
 
-		SCR_CampaignFaction enemyFaction = factionManager.GetEnemyFaction(ourFaction);
-		if (!enemyFaction)
-			return true;
+	//------------------------------------------------------------------------------------------------
+	//! Get keys of every faction hostile to our faction (e.g. both BLUFOR and FIA)
+	//------------------------------------------------------------------------------------------------
+	void GetHostileFactionKeys(notnull array<string> hostileFactionKeys)
+	{
+		FactionManager factionManager = GetGame().GetFactionManager();
+		if (!factionManager || !m_Faction)
+			return;
 
-		// Check if any enemy base is within attack range
-		array<SCR_CampaignMilitaryBaseComponent> enemyBases = {};
-		baseManager.GetBases(enemyBases, enemyFaction);
+		array<Faction> factions = {};
+		factionManager.GetFactionsList(factions);
 
-		vector ourPos = base.GetOwner().GetOrigin();
-		foreach (SCR_CampaignMilitaryBaseComponent enemyBase : enemyBases)
+		foreach (Faction faction : factions)
 		{
-			float distance = vector.Distance(ourPos, enemyBase.GetOwner().GetOrigin());
-			if (distance < FRONTLINE_RANGE)
-				return true; // Enemy base nearby - this is frontline
+			if (faction != m_Faction && m_Faction.IsFactionEnemy(faction))
+				hostileFactionKeys.Insert(faction.GetFactionKey());
 		}
-
-		return false; // No enemy bases nearby - this is rear area
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -1204,27 +1776,40 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 			return;
 		}
 
+		// Decided by the frontline channel (RunBaseChannels)
+		SetIsNearTarget(m_bKeepDefendersActive);
+		SetIsTargetChanged(false);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Frontline channel: decide whether the defenders of this base stay active
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateFrontline(IPC_CombatSnapshot snapshot)
+	{
+		IPC_TraceRecorder.RecordTargetUpdate(snapshot, this);
+
 		// Only apply frontline detection to friendly bases
 		// Enemy bases use the parent mod's default behavior (always active when base exists)
-		if (!IsBaseFriendly(m_nearBase))
+		if (!IsBaseFriendly(snapshot, m_nearBase))
 		{
-			// Use parent mod's default behavior for enemy bases
-			SetIsNearTarget(true);
-			SetIsTargetChanged(false);
+			m_bKeepDefendersActive = true;
+
+			// Player factions can change without a base changing owner
+			m_Channels.MarkDirty(IPC_EBaseChannel.FRONTLINE);
 			return;
 		}
 
-		// For friendly bases, use frontline detection logic
-		bool shouldKeepActive = ShouldKeepDefendersActive();
-		SetIsNearTarget(shouldKeepActive);
+		m_bKeepDefendersActive = ShouldKeepDefendersActive(snapshot);
 
-		if (!shouldKeepActive && DEBUG_MODE)
+		// A running grace period has to be re-checked until it expires or the base is back on the frontline
+		if (m_DecisionState.m_fInactiveSince >= 0)
+			m_Channels.MarkDirty(IPC_EBaseChannel.FRONTLINE);
+
+		if (!m_bKeepDefendersActive && IsDebugMode())
 		{
 			PrintFormat("[IPC Defender DEBUG] Base %1 marked for despawn (not on frontline)",
 						m_nearBase.GetOwner().GetName());
 		}
-
-		SetIsTargetChanged(false);
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -1232,10 +1817,12 @@ modded class IPC_DefenderSpawnPointComponent : IPC_SpawnPointComponent
 	//------------------------------------------------------------------------------------------------
 	void ~IPC_DefenderSpawnPointComponent()
 	{
-		// Remove the periodic check callback if we're the coordinator
+		IPC_BaseChannelScheduler.GetInstance().Unregister(this);
+
+		// Remove this coordinator from the director schedule
 		if (m_bIsReinforcementCoordinator)
 		{
-			GetGame().GetCallqueue().Remove(CheckReinforcements);
+			IPC_ReinforcementDirector.GetInstance().Unregister(this);
 			PrintFormat("[IPC Reinforcement] Cleaned up coordinator callbacks for %1", GetOwner().GetName());
 		}
 
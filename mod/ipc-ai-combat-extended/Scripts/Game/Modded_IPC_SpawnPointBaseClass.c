@@ -2,17 +2,50 @@
 // IPC AI Combat Extended - Modded Base Spawn Point Class
 // Extends base IPC mod to adjust AI perception for solo players
 // Requirements: Solo players (1 player) get 1.0x perception instead of 1.5x
+//               (value from IPC_ExtendedConfig.m_fSoloPerception)
+// Respawns are admitted by CanRespawnNow() and IPC_AIBudget (defender / attacker share of the AI limit)
 //------------------------------------------------------------------------------------------------
 
 modded class IPC_SpawnPointComponent : ScriptComponent
 {
+	//------------------------------------------------------------------------------------------------
+	//! Apply runtime configuration to this spawn point (called on init and on every config reload)
+	//! Derived spawn points override this to push their tunables
+	void ApplyExtendedConfig(IPC_ExtendedConfig config)
+	{
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! AI budget subsystem this spawn point's respawns count against
+	IPC_EAIBudgetSubsystem GetAIBudgetSubsystem()
+	{
+		return IPC_EAIBudgetSubsystem.DEFENDERS;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Extra spawn gate for derived spawn points (false = skip this respawn, retried next respawn period)
+	bool CanRespawnNow()
+	{
+		return true;
+	}
+
 	//------------------------------------------------------------------------------------------------
 	//! Override SpawnPatrol to adjust AI perception for solo players
 	//! Keeps EXPERT skill level but reduces perception to 1.0x for single player
 	override void SpawnPatrol()
 	{
-		// Call parent implementation to handle all spawn logic
+		if (!CanRespawnNow())
+			return;
+
+		// Respawn is skipped (retried next respawn period) if it would eat into another subsystem's reservation
+		IPC_AIBudget budget = IPC_AIBudget.GetInstance();
+		if (!budget.CanSpawn(GetAIBudgetSubsystem(), IPC_AIBudget.EstimateAgents(m_iNum, m_sPrefab)))
+			return;
+
+		// Call parent implementation to handle all spawn logic (position search included - booked on the base)
+		int startTick = IPC_ScriptTimer.Start();
 		super.SpawnPatrol();
+		budget.Track(m_Group, GetAIBudgetSubsystem());
 
 		// Get current player count
 		int players = GetGame().GetPlayerManager().GetPlayerCount();
@@ -20,6 +53,8 @@ modded class IPC_SpawnPointComponent : ScriptComponent
 		// Only adjust for solo players
 		if (players == 1)
 		{
+			float soloPerception = IPC_ExtendedConfig.GetInstance().m_fSoloPerception;
+
 			// Get all agents in the spawned group
 			array<AIAgent> agents = {};
 			if (m_Group)
@@ -43,12 +78,14 @@ modded class IPC_SpawnPointComponent : ScriptComponent
 
 					// Keep EXPERT skill, but reduce perception to 1.0x for solo players
 					CombatComponent.SetAISkill(EAISkill.EXPERT);
-					CombatComponent.SetPerceptionFactor(1.0);
+					CombatComponent.SetPerceptionFactor(soloPerception);
 
 					// Debug logging
-					PrintFormat("[IPC Extended] Solo player mode - AI skill: EXPERT, Perception: 1.0x");
+					PrintFormat("[IPC Extended] Solo player mode - AI skill: EXPERT, Perception: %1x", soloPerception);
 				}
 			}
 		}
+
+		IPC_BaseCostLedger.Add(m_nearBase, IPC_ECostCategory.SPAWNING, startTick);
 	}
 }
@@ -0,0 +1,16 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Modded Game Mode
+// Credits player kills to the reinforcement group of the killer (IPC_WaveMetrics)
+//------------------------------------------------------------------------------------------------
+
+modded class SCR_BaseGameMode
+{
+	//------------------------------------------------------------------------------------------------
+	override protected void OnPlayerKilled(notnull SCR_InstigatorContextData instigatorContextData)
+	{
+		super.OnPlayerKilled(instigatorContextData);
+
+		if (IsMaster())
+			IPC_WaveMetrics.GetInstance().OnPlayerKilledBy(instigatorContextData.GetKillerEntity());
+	}
+}
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------------------------
+// IPC AI Combat Extended - Modded Player Controller
+// Receives the admin performance overlay (IPC_AdminOverlay) and draws it on the owning client
+//
+// Payload: total row count plus only the rows that changed (index + text + elapsed timer seconds,
+// -1 = no timer). A row count of 0 hides the overlay. Row timers are counted up locally and the
+// widget is redrawn once per second while the overlay is shown.
+//------------------------------------------------------------------------------------------------
+
+modded class SCR_PlayerController
+{
+	protected ref array<string> m_aIPCOverlayRows = {};
+	protected ref array<float> m_aIPCOverlayTimerStarts = {};	// Local world time (ms) each row's timer started at, -1 = none
+	protected RichTextWidget m_wIPCOverlay;
+	protected bool m_bIPCOverlayTicking;
+
+	//------------------------------------------------------------------------------------------------
+	//! Send changed overlay rows to the owning client (server only)
+	//------------------------------------------------------------------------------------------------
+	void IPC_SendOverlayDelta(int rowCount, notnull array<int> indices, notnull array<string> rows, notnull array<int> timers)
+	{
+		// Listen server host owns its own controller - apply locally
+		RplComponent rplComponent = RplComponent.Cast(FindComponent(RplComponent));
+		if (rplComponent && rplComponent.IsOwner())
+		{
+			RpcDo_IPCOverlayDelta(rowCount, indices, rows, timers);
+			return;
+		}
+
+		Rpc(RpcDo_IPCOverlayDelta, rowCount, indices, rows, timers);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_IPCOverlayDelta(int rowCount, array<int> indices, array<string> rows, array<int> timers)
+	{
+		m_aIPCOverlayRows.Resize(rowCount);
+		m_aIPCOverlayTimerStarts.Resize(rowCount);
+
+		float now = GetGame().GetWorld().GetWorldTime();
+		foreach (int i, int rowIndex : indices)
+		{
+			if (rowIndex >= rowCount || i >= rows.Count() || i >= timers.Count())
+				continue;
+
+			m_aIPCOverlayRows[rowIndex] = rows[i];
+			m_aIPCOverlayTimerStarts[rowIndex] = -1;
+			if (timers[i] >= 0)
+				m_aIPCOverlayTimerStarts[rowIndex] = now - timers[i] * 1000.0;
+		}
+
+		UpdateIPCOverlayWidget();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected void UpdateIPCOverlayWidget()
+	{
+		if (m_aIPCOverlayRows.IsEmpty())
+		{
+			if (m_wIPCOverlay)
+			{
+				m_wIPCOverlay.RemoveFromHierarchy();
+				m_wIPCOverlay = null;
+			}
+
+			if (m_bIPCOverlayTicking)
+			{
+				GetGame().GetCallqueue().Remove(UpdateIPCOverlayWidget);
+				m_bIPCOverlayTicking = false;
+			}
+
+			return;
+		}
+
+		// Redraw every second so row timers keep counting between server updates
+		if (!m_bIPCOverlayTicking)
+		{
+			m_bIPCOverlayTicking = true;
+			GetGame().GetCallqueue().CallLater(UpdateIPCOverlayWidget, 1000, true);
+		}
+
+		if (!m_wIPCOverlay)
+		{
+			WorkspaceWidget workspace = GetGame().GetWorkspace();
+			if (!workspace)
+				return;
+
+			m_wIPCOverlay = RichTextWidget.Cast(workspace.CreateWidgetInWorkspace(WidgetType.RichTextWidgetTypeID, 16, 160, 640, 480,
+				WidgetFlags.VISIBLE | WidgetFlags.NOFOCUS | WidgetFlags.IGNORE_CURSOR, Color.FromInt(Color.WHITE), 1000));
+			if (!m_wIPCOverlay)
+				return;
+		}
+
+		float now = GetGame().GetWorld().GetWorldTime();
+		string text = "IPC Extended";
+		foreach (int i, string row : m_aIPCOverlayRows)
+		{
+			string line = row;
+			float timerStart = m_aIPCOverlayTimerStarts[i];
+			if (timerStart >= 0)
+			{
+				int elapsed = Math.Floor((now - timerStart) / 1000.0);
+				line.Replace(IPC_AdminOverlay.TIMER_TOKEN, elapsed.ToString());
+			}
+
+			text += "\n" + line;
+		}
+
+		m_wIPCOverlay.SetText(text);
+	}
+}